@@ -0,0 +1,234 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <fmt/format.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/factory.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+// measures the latency (as seen by the caller) of individual log calls for all handler types
+// usage: roq-logging-benchmark [--iterations N] [--type TYPE]... (all types if none)
+// note! stdout is redirected to /dev/null while measuring (handlers without a path will log to stdout)
+
+// === CONSTANTS ===
+
+namespace {
+auto const DEFAULT_ITERATIONS = 100000uz;
+auto const WARMUP_ITERATIONS = 1000uz;
+auto const CALIBRATION_PERIOD = 100ms;
+
+struct Config final {
+  std::string_view name;
+  std::string_view type;
+  bool deferred = {};
+  uint64_t queue_capacity = {};
+};
+
+auto const CONFIGS = std::array{
+    Config{.name = "standard"sv, .type = "standard"sv},
+    Config{.name = "spdlog"sv, .type = "spdlog"sv},
+    Config{.name = "ring"sv, .type = "ring"sv},
+    Config{.name = "ring (deferred)"sv, .type = "ring"sv, .deferred = true},
+    Config{.name = "shm"sv, .type = "shm"sv, .queue_capacity = 256uz * 1024 * 1024},  // note! no consumer, must not drop
+};
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! rdtsc (if available) is converted to nanoseconds using a one-time calibration
+struct Clock final {
+  Clock() {
+#if defined(__x86_64__)
+    auto ticks = __rdtsc();
+    auto time = get_monotonic();
+    std::this_thread::sleep_for(CALIBRATION_PERIOD);
+    auto delta_ticks = __rdtsc() - ticks;
+    auto delta_time = get_monotonic() - time;
+    scale_ = static_cast<double>(delta_time) / static_cast<double>(delta_ticks);
+#endif
+  }
+
+  uint64_t now() const {
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return get_monotonic();
+#endif
+  }
+
+  uint64_t to_nanoseconds(uint64_t ticks) const { return static_cast<uint64_t>(static_cast<double>(ticks) * scale_); }
+
+ protected:
+  static uint64_t get_monotonic() {
+    struct timespec time = {};
+    ::clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+  }
+
+ private:
+  double scale_ = 1.0;  // note! nanoseconds per tick
+};
+
+// note! keeps stdout away from the terminal (and the terminal away from the measurements)
+struct Redirect final {
+  Redirect() : fd_{::dup(STDOUT_FILENO)} {
+    std::fflush(stdout);
+    auto fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    ::dup2(fd, STDOUT_FILENO);
+    ::close(fd);
+  }
+
+  Redirect(Redirect const &) = delete;
+
+  ~Redirect() {
+    std::fflush(stdout);
+    ::dup2(fd_, STDOUT_FILENO);
+    ::close(fd_);
+  }
+
+ private:
+  int const fd_;
+};
+
+// note! the shm handler keeps the segment (nothing has been consumed)
+struct SharedMemory final {
+  explicit SharedMemory(std::string_view const &type) : name_{type == "shm"sv ? fmt::format("roq-logging-benchmark-{}"sv, ::getpid()) : ""s} {}
+
+  SharedMemory(SharedMemory const &) = delete;
+
+  ~SharedMemory() {
+    if (!std::empty(name_)) {
+      ::shm_unlink(fmt::format("/{}"sv, name_).c_str());
+    }
+  }
+
+  std::string_view name() const { return name_; }
+
+ private:
+  std::string const name_;
+};
+
+struct Result final {
+  std::string_view name;
+  uint64_t p50 = {};
+  uint64_t p99 = {};
+  uint64_t p999 = {};
+  uint64_t max = {};
+};
+
+template <typename Callback>
+auto measure(Clock const &clock, std::string_view const &name, size_t iterations, Callback callback) {
+  for (size_t i = 0; i < WARMUP_ITERATIONS; ++i) {
+    callback(i);
+  }
+  std::vector<uint64_t> samples(iterations);
+  for (size_t i = 0; i < iterations; ++i) {
+    auto start = clock.now();
+    callback(i);
+    samples[i] = clock.now() - start;
+  }
+  std::sort(std::begin(samples), std::end(samples));
+  auto percentile = [&](double value) { return clock.to_nanoseconds(samples[static_cast<size_t>(value * static_cast<double>(iterations - 1))]); };
+  return Result{
+      .name = name,
+      .p50 = percentile(0.5),
+      .p99 = percentile(0.99),
+      .p999 = percentile(0.999),
+      .max = clock.to_nanoseconds(samples.back()),
+  };
+}
+
+auto run(Clock const &clock, Config const &config, size_t iterations) {
+  std::vector<Result> results;
+  SharedMemory shared_memory{config.type};
+  Settings settings;
+  settings.log.deferred = config.deferred;
+  settings.log.queue_capacity = config.queue_capacity;
+  settings.log.shm_name = shared_memory.name();
+  Redirect redirect;
+  auto handler = Factory::create(config.type, settings);
+  results.emplace_back(measure(clock, "info (0 args)"sv, iterations, [](auto) { log::info("hello world"sv); }));
+  results.emplace_back(measure(clock, "info (3 args)"sv, iterations, [](auto i) { log::info("i={}, d={}, s={}"sv, i, 3.14, "abc"sv); }));
+  results.emplace_back(measure(clock, "info (8 args)"sv, iterations, [](auto i) {
+    log::info("a={}, b={}, c={}, d={}, e={}, f={}, g={}, h={}"sv, i, i + 1, 3.14, "abc"sv, true, 'x', -1, uint64_t{42});
+  }));
+  results.emplace_back(measure(clock, "info<5> (filtered)"sv, iterations, [](auto i) { log::info<5>("i={}"sv, i); }));
+  results.emplace_back(measure(clock, "system_error"sv, iterations, [](auto i) {
+    errno = EAGAIN;
+    log::system_error("i={}"sv, i);
+  }));
+  return results;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+int main(int argc, char **argv) {
+  auto iterations = DEFAULT_ITERATIONS;
+  std::vector<std::string_view> types;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--iterations"sv && (i + 1) < argc) {
+      iterations = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--type"sv && (i + 1) < argc) {
+      types.emplace_back(argv[++i]);
+    } else if (arg == "--help"sv) {
+      fmt::println("usage: {} [--iterations N] [--type TYPE]..."sv, argv[0]);
+      return EXIT_SUCCESS;
+    } else {
+      fmt::println(stderr, R"(Unknown argument: "{}")"sv, arg);
+      return EXIT_FAILURE;
+    }
+  }
+  if (iterations == 0) {
+    fmt::println(stderr, "Iterations must be positive"sv);
+    return EXIT_FAILURE;
+  }
+  Clock clock;
+  fmt::println("{:<16} {:<20} {:>10} {:>10} {:>10} {:>10}"sv, "type"sv, "case"sv, "p50 (ns)"sv, "p99 (ns)"sv, "p99.9 (ns)"sv, "max (ns)"sv);
+  try {
+    for (auto &config : CONFIGS) {
+      if (!std::empty(types) && std::find(std::begin(types), std::end(types), config.type) == std::end(types)) {
+        continue;
+      }
+      auto results = run(clock, config, iterations);
+      for (auto &result : results) {
+        fmt::println("{:<16} {:<20} {:>10} {:>10} {:>10} {:>10}"sv, config.name, result.name, result.p50, result.p99, result.p999, result.max);
+      }
+    }
+  } catch (std::exception &e) {
+    fmt::println(stderr, R"(Exception: what="{}")"sv, e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
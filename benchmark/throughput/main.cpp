@@ -0,0 +1,264 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <fmt/format.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/factory.hpp"
+#include "roq/logging/stats.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+// measures sustained end-to-end throughput (including the disk sink) for an increasing number of producer threads
+// usage: roq-logging-benchmark-throughput [--type TYPE] [--messages N] [--threads N]... [--overflow_policy POLICY] [--metrics] [--directory DIR]
+// - throughput is measured from the first message until the handler has been destroyed (all messages written)
+// - backend cpu is approximated as process cpu time not used by the producer threads
+// - queue-full events are only visible as dropped messages (use a drop overflow policy)
+// - --metrics adds queue depth and write time (only some handlers) but also adds overhead to each call
+// - the log file is verified afterwards (lost and reordered messages are counted per producer thread)
+
+// === CONSTANTS ===
+
+namespace {
+auto const DEFAULT_TYPE = "spdlog"sv;
+auto const DEFAULT_MESSAGES = 1000000uz;  // note! total (divided between producer threads)
+auto const DEFAULT_THREADS = std::array{1uz, 2uz, 4uz, 8uz, 16uz};
+auto const MAX_SIZE = uint64_t{1} << 40;  // note! never rotate (simplifies verification)
+auto const SAMPLE_FREQ = 1ms;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+auto get_cpu_time(clockid_t clock_id) {
+  struct timespec time = {};
+  ::clock_gettime(clock_id, &time);
+  return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+}
+
+struct Result final {
+  size_t threads = {};
+  std::chrono::nanoseconds elapsed = {};
+  uint64_t messages = {};
+  uint64_t bytes = {};
+  uint64_t dropped = {};
+  uint64_t queue_depth_max = {};
+  std::chrono::nanoseconds producer_cpu = {};
+  std::chrono::nanoseconds backend_cpu = {};
+  std::chrono::nanoseconds write_time = {};
+  uint64_t lost = {};
+  uint64_t reordered = {};
+};
+
+// note! lines look like "... thread=T, seq=S"
+void verify(std::filesystem::path const &path, size_t threads, size_t messages, Result &result) {
+  std::vector<int64_t> last(threads, -1);
+  std::vector<uint64_t> received(threads);
+  std::ifstream file{path};
+  std::string line;
+  while (std::getline(file, line)) {
+    auto offset = line.find("thread="sv);
+    if (offset == line.npos) {
+      continue;
+    }
+    char *end = nullptr;
+    auto thread = std::strtoull(std::data(line) + offset + 7, &end, 10);
+    auto seq = std::strtoll(end + std::size(", seq="sv), nullptr, 10);
+    if (thread >= threads) {
+      continue;
+    }
+    if (seq <= last[thread]) {
+      ++result.reordered;
+    }
+    last[thread] = std::max(last[thread], static_cast<int64_t>(seq));
+    ++received[thread];
+  }
+  for (size_t i = 0; i < threads; ++i) {
+    if (received[i] < messages) {
+      result.lost += messages - received[i];
+    }
+  }
+}
+
+auto run(std::string_view const &type, std::string_view const &overflow_policy, std::filesystem::path const &directory, size_t threads, size_t messages) {
+  Result result{
+      .threads = threads,
+      .messages = threads * messages,
+  };
+  auto path = directory / fmt::format("throughput-{}.log"sv, threads);
+  auto path_2 = path.string();
+  Settings settings;
+  settings.log.path = path_2;
+  settings.log.max_size = MAX_SIZE;
+  settings.log.max_files = 1;
+  settings.log.overflow_policy = overflow_policy;
+  std::atomic<bool> start = {};
+  std::atomic<bool> done = {};
+  std::atomic<int64_t> producer_cpu = {};
+  auto process_cpu = get_cpu_time(CLOCK_PROCESS_CPUTIME_ID);
+  auto begin = std::chrono::steady_clock::now();
+  {
+    auto handler = Factory::create(type, settings);
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < threads; ++i) {
+      producers.emplace_back([&, i]() {
+        while (!start.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        auto cpu = get_cpu_time(CLOCK_THREAD_CPUTIME_ID);
+        for (size_t j = 0; j < messages; ++j) {
+          log::info("thread={}, seq={}"sv, i, j);
+        }
+        producer_cpu.fetch_add((get_cpu_time(CLOCK_THREAD_CPUTIME_ID) - cpu).count(), std::memory_order_relaxed);
+      });
+    }
+    // note! sampling the queue depth (high-water)
+    std::thread sampler{[&]() {
+      while (!done.load(std::memory_order_acquire)) {
+        (*handler).get_stats();
+        std::this_thread::sleep_for(SAMPLE_FREQ);
+      }
+    }};
+    begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto &producer : producers) {
+      producer.join();
+    }
+    done.store(true, std::memory_order_release);
+    sampler.join();
+    auto stats = (*handler).get_stats();
+    for (auto dropped : stats.dropped) {
+      result.dropped += dropped;
+    }
+    result.queue_depth_max = stats.queue_depth_max;
+    result.write_time = stats.write_time;
+  }
+  result.elapsed = std::chrono::steady_clock::now() - begin;
+  result.producer_cpu = std::chrono::nanoseconds{producer_cpu.load(std::memory_order_relaxed)};
+  result.backend_cpu = (get_cpu_time(CLOCK_PROCESS_CPUTIME_ID) - process_cpu) - result.producer_cpu;
+  result.bytes = std::filesystem::file_size(path);
+  verify(path, threads, messages, result);
+  std::filesystem::remove(path);
+  return result;
+}
+
+void print_header() {
+  fmt::println(
+      "{:>7} {:>12} {:>10} {:>8} {:>10} {:>12} {:>12} {:>12} {:>12} {:>8} {:>10}"sv,
+      "threads"sv,
+      "msg/s"sv,
+      "MB/s"sv,
+      "dropped"sv,
+      "queue max"sv,
+      "producer cpu"sv,
+      "backend cpu"sv,
+      "backend %"sv,
+      "write %"sv,
+      "lost"sv,
+      "reordered"sv);
+}
+
+void print_result(Result const &result) {
+  auto seconds = std::chrono::duration<double>(result.elapsed).count();
+  auto backend = std::chrono::duration<double>(result.backend_cpu).count();
+  auto write = std::chrono::duration<double>(result.write_time).count();
+  fmt::println(
+      "{:>7} {:>12.0f} {:>10.1f} {:>8} {:>10} {:>11.3f}s {:>11.3f}s {:>11.1f}% {:>11.1f}% {:>8} {:>10}"sv,
+      result.threads,
+      static_cast<double>(result.messages) / seconds,
+      static_cast<double>(result.bytes) / (seconds * 1048576.0),
+      result.dropped,
+      result.queue_depth_max,
+      std::chrono::duration<double>(result.producer_cpu).count(),
+      backend,
+      100.0 * backend / seconds,
+      backend > 0.0 ? 100.0 * write / backend : 0.0,
+      result.lost,
+      result.reordered);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+int main(int argc, char **argv) {
+  auto type = DEFAULT_TYPE;
+  auto messages = DEFAULT_MESSAGES;
+  std::vector<size_t> threads;
+  auto overflow_policy = "block"sv;
+  auto metrics_2 = false;
+  std::filesystem::path directory;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--type"sv && (i + 1) < argc) {
+      type = argv[++i];
+    } else if (arg == "--messages"sv && (i + 1) < argc) {
+      messages = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--threads"sv && (i + 1) < argc) {
+      threads.emplace_back(std::strtoull(argv[++i], nullptr, 10));
+    } else if (arg == "--overflow_policy"sv && (i + 1) < argc) {
+      overflow_policy = argv[++i];
+    } else if (arg == "--metrics"sv) {
+      metrics_2 = true;
+    } else if (arg == "--directory"sv && (i + 1) < argc) {
+      directory = argv[++i];
+    } else if (arg == "--help"sv) {
+      fmt::println("usage: {} [--type TYPE] [--messages N] [--threads N]... [--overflow_policy POLICY] [--metrics] [--directory DIR]"sv, argv[0]);
+      return EXIT_SUCCESS;
+    } else {
+      fmt::println(stderr, R"(Unknown argument: "{}")"sv, arg);
+      return EXIT_FAILURE;
+    }
+  }
+  if (std::empty(threads)) {
+    threads.assign(std::begin(DEFAULT_THREADS), std::end(DEFAULT_THREADS));
+  }
+  if (std::any_of(std::begin(threads), std::end(threads), [](auto value) { return value == 0; })) {
+    fmt::println(stderr, "Threads must be positive"sv);
+    return EXIT_FAILURE;
+  }
+  try {
+    auto temporary = std::empty(directory);
+    if (temporary) {
+      auto tmp = (std::filesystem::temp_directory_path() / "roq-logging-benchmark-XXXXXX").string();
+      if (::mkdtemp(std::data(tmp)) == nullptr) {
+        fmt::println(stderr, "Unable to create temporary directory"sv);
+        return EXIT_FAILURE;
+      }
+      directory = tmp;
+    }
+    metrics = metrics_2;
+    fmt::println(
+        R"(type="{}", messages={}, overflow_policy="{}", metrics={}, directory="{}")"sv, type, messages, overflow_policy, metrics_2, directory.string());
+    print_header();
+    for (auto count : threads) {
+      print_result(run(type, overflow_policy, directory, count, std::max(messages / count, 1uz)));
+    }
+    if (temporary) {
+      std::filesystem::remove_all(directory);
+    }
+  } catch (std::exception &e) {
+    fmt::println(stderr, R"(Exception: what="{}")"sv, e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -5,21 +5,106 @@
 #include <fmt/color.h>
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <new>
+#include <type_traits>
 
 #include "roq/format_str.hpp"
 
+#include "roq/logging/deferred.hpp"
+#include "roq/logging/error.hpp"
 #include "roq/logging/handler.hpp"
+#include "roq/logging/metrics.hpp"
 #include "roq/logging/shared.hpp"
+#include "roq/logging/site.hpp"
+#include "roq/logging/static_handler.hpp"
+#include "roq/logging/structured.hpp"
+#include "roq/logging/vmodule.hpp"
+
+// compile-time filtering (call-sites are compiled down to nothing)
+// - ROQ_LOGGING_MIN_LEVEL: strip levels below (0=DEBUG, 1=INFO, 2=WARNING, 3=ERROR, 4=CRITICAL)
+// - ROQ_LOGGING_MAX_VERBOSITY: strip verbosity levels above
+// note! critical and fatal are never stripped
+
+#ifndef ROQ_LOGGING_MIN_LEVEL
+#define ROQ_LOGGING_MIN_LEVEL 0
+#endif
+
+#ifndef ROQ_LOGGING_MAX_VERBOSITY
+#define ROQ_LOGGING_MAX_VERBOSITY SIZE_MAX
+#endif
 
 namespace roq {
 
 namespace log {
 
 namespace detail {
-template <size_t level, typename... Args>
-static void helper(roq::logging::Level log_level, roq::format_str const &fmt, Args &&...args) {
-  using namespace std::literals;
+static constexpr auto const MIN_LEVEL = static_cast<roq::logging::Level>(ROQ_LOGGING_MIN_LEVEL);
+static constexpr size_t const MAX_VERBOSITY = ROQ_LOGGING_MAX_VERBOSITY;
+
+static_assert(MIN_LEVEL >= roq::logging::Level::DEBUG && MIN_LEVEL <= roq::logging::Level::CRITICAL);
+
+// note! internal linkage (like MIN_LEVEL and MAX_VERBOSITY), translation units may be built with different limits
+template <roq::logging::Level log_level, size_t level>
+static constexpr bool is_enabled = log_level >= MIN_LEVEL && level <= MAX_VERBOSITY;
+
+// note! the callback returns the message length (metrics are only collected when enabled)
+template <typename Callback>
+static void measure(roq::logging::Level log_level, Callback &&callback) {
+  if (!roq::logging::metrics.load(std::memory_order_relaxed)) [[likely]] {
+    callback();
+    return;
+  }
+  auto &metrics = roq::logging::detail::producer_metrics;
+  auto start = metrics.now();
+  auto length = callback();
+  metrics(log_level, length, metrics.now() - start);
+}
+
+// note! size tag used when formatting into the message buffer (unbounded, the length is then the size of the message buffer)
+struct Unbounded final {
+  constexpr operator size_t() const { return SIZE_MAX; }
+};
+
+// note! the handler bound at build time (ROQ_LOGGING_STATIC_HANDLER) avoids the virtual calls
+static decltype(auto) get_handler() {
+#if defined(ROQ_LOGGING_STATIC_HANDLER)
+  return roq::logging::StaticHandler{};
+#else
+  return roq::logging::Handler::get_instance();
+#endif
+}
+
+// note! the callback formats into a bounded range and returns the full (untruncated) length
+template <typename Callback>
+static size_t dispatch(roq::logging::Level log_level, Callback &&callback) {
+  auto &&handler = get_handler();
+  auto length = 0uz;
+  // note! only calls reserve if the handler has opted in (avoids a virtual call when not supported)
+  if (handler.is_two_phase()) [[likely]] {
+    auto buffer = handler.reserve(log_level);
+    if (!std::empty(buffer)) [[likely]] {
+      // note! format straight into memory owned by the handler (the reservation must be released if the formatter throws)
+      try {
+        length = callback(std::data(buffer), std::size(buffer));
+      } catch (...) {
+        handler.commit(log_level, 0);
+        throw;
+      }
+      if (length <= std::size(buffer)) [[likely]] {
+        handler.commit(log_level, length);
+        return length;
+      }
+      handler.commit(log_level, 0);  // note! discard, message too long
+    }
+  }
   auto &message = roq::logging::message_buffer;
 #ifndef NDEBUG
   auto capacity = message.capacity();
@@ -28,115 +113,342 @@ static void helper(roq::logging::Level log_level, roq::format_str const &fmt, Ar
 #ifndef NDEBUG
   assert(capacity == message.capacity());
 #endif
-  fmt::format_to(std::back_inserter(message), "L{} {}:{}] "sv, level, fmt.file_name, fmt.line);
-  fmt::vformat_to(std::back_inserter(message), fmt.str, fmt::make_format_args(args...));
-  roq::logging::Handler::get_instance()(log_level, message);
+  if (length != 0) {
+    message.resize(length);
+    callback(std::data(message), length);
+  } else {
+    callback(std::back_inserter(message), Unbounded{});  // note! plain format_to (reserve not supported)
+  }
+  handler(log_level, message);
+  return std::size(message);
+}
+
+// note! returns 0 if the handler doesn't support (or hasn't enabled) deferred formatting, otherwise the size of the captured arguments
+template <typename... Args>
+static size_t dispatch_deferred(roq::logging::Level log_level, roq::logging::Site const &site, int error, Args &&...args) {
+  using value_type = roq::logging::detail::Deferred<std::remove_cvref_t<Args>...>;
+  auto &&handler = get_handler();
+  if (!handler.is_two_phase()) {
+    return 0;
+  }
+  auto &codec = roq::logging::detail::CODEC<std::remove_cvref_t<Args>...>;
+  auto buffer = handler.reserve_deferred(log_level, codec, sizeof(value_type));
+  if (std::empty(buffer)) {
+    return 0;
+  }
+  new (std::data(buffer)) value_type{
+      .site = &site,
+      .error = error,
+      .args = {args...},
+  };
+  handler.commit(log_level, sizeof(value_type));
+  return sizeof(value_type);
+}
+
+template <typename... Args>
+inline constexpr bool is_deferrable = (roq::logging::is_deferrable_v<std::remove_cvref_t<Args>> && ...);
+
+// note! bounded copy, length is the full (untruncated) length written so far
+template <typename OutputIt>
+static OutputIt append(OutputIt out, size_t size, size_t &length, std::string_view const &text) {
+  auto available = length < size ? (size - length) : 0uz;
+  auto count = std::min(std::size(text), available);
+  length += std::size(text);
+  return std::copy_n(std::data(text), count, out);
+}
+
+template <typename OutputIt>
+static OutputIt append(OutputIt out, Unbounded, size_t &length, std::string_view const &text) {
+  length += std::size(text);
+  return std::copy(std::begin(text), std::end(text), out);
+}
+
+// note! bounded format, returns the full (untruncated) length
+template <typename OutputIt>
+static size_t vformat(OutputIt out, size_t size, size_t length, fmt::string_view fmt, fmt::format_args args) {
+  return length + fmt::vformat_to_n(out, size - std::min(length, size), fmt, args).size;
+}
+
+template <typename OutputIt>
+static size_t vformat(OutputIt out, Unbounded, size_t length, fmt::string_view fmt, fmt::format_args args) {
+  fmt::vformat_to(out, fmt, args);
+  return length;  // note! not used
+}
+
+// note! Tag is unique for each call-site (a lambda in a default template argument), the registry is therefore only probed once
+template <typename Tag>
+static roq::logging::Site const &get_site(roq::logging::Level log_level, size_t level, roq::logging::Prefix prefix, roq::format_str const &fmt) {
+  static auto &site = roq::logging::get_site(log_level, level, prefix, fmt);
+  return site;
+}
+
+// note! a matching vmodule pattern overrides the global verbosity (the site is only needed when some pattern exists)
+template <typename Tag>
+static bool is_verbose(roq::logging::Level log_level, size_t level, roq::logging::Prefix prefix, roq::format_str const &fmt) {
+  auto verbosity = roq::logging::verbosity.load(std::memory_order_relaxed);
+  if (!roq::logging::detail::has_vmodule.load(std::memory_order_relaxed)) [[likely]] {
+    return verbosity >= level;
+  }
+  return roq::logging::detail::is_vmodule_enabled(get_site<Tag>(log_level, level, prefix, fmt), level, verbosity);
+}
+
+// note! the prefix has been formatted once per call-site (when registering)
+template <typename... Args>
+static void helper_site(roq::logging::Level log_level, roq::logging::Site const &site, roq::format_str const &fmt, Args &&...args) {
+  measure(log_level, [&]() {
+    if constexpr (is_deferrable<Args...>) {
+      auto length = dispatch_deferred(log_level, site, 0, args...);
+      if (length != 0) {
+        return length;
+      }
+    }
+    return dispatch(log_level, [&](auto out, auto size) {
+      size_t length = {};
+      auto out_2 = append(out, size, length, site.header);
+      return vformat(out_2, size, length, fmt.str, fmt::make_format_args(args...));
+    });
+  });
+}
+
+template <typename Tag, size_t level, typename... Args>
+static void helper(roq::logging::Level log_level, roq::format_str const &fmt, Args &&...args) {
+  auto &site = get_site<Tag>(log_level, level, roq::logging::Prefix::DEFAULT, fmt);
+  helper_site(log_level, site, fmt, std::forward<Args>(args)...);
 }
 
 #ifndef NDEBUG
-template <size_t level, typename... Args>
+template <typename Tag, size_t level, typename... Args>
 static void helper_debug(roq::logging::Level log_level, roq::format_str const &fmt, Args &&...args) {
-  using namespace std::literals;
-  auto &message = roq::logging::message_buffer;
-  message.clear();  // note! capacity is in reality preserved but it is not guaranteed by the standard
-  fmt::format_to(std::back_inserter(message), "L{} {}:{}] DEBUG: "sv, level, fmt.file_name, fmt.line);
-  fmt::vformat_to(std::back_inserter(message), fmt.str, fmt::make_format_args(args...));
-  roq::logging::Handler::get_instance()(log_level, message);
+  auto &site = get_site<Tag>(log_level, level, roq::logging::Prefix::DEBUG, fmt);
+  helper_site(log_level, site, fmt, std::forward<Args>(args)...);
 }
 #endif
 
-template <size_t level, typename... Args>
+template <typename... Args>
+static void helper_system_error_site(roq::logging::Level log_level, roq::logging::Site const &site, int error, roq::format_str const &fmt, Args &&...args) {
+  using namespace std::literals;
+  measure(log_level, [&]() {
+    if constexpr (is_deferrable<Args...>) {
+      auto length = dispatch_deferred(log_level, site, error, args...);
+      if (length != 0) {
+        return length;
+      }
+    }
+    // note! "{text} [{error}] "
+    std::array<char, 16> number;
+    number[0] = ' ';
+    number[1] = '[';
+    auto last = std::to_chars(std::data(number) + 2, std::data(number) + std::size(number) - 2, error).ptr;
+    *last++ = ']';
+    *last++ = ' ';
+    std::string_view suffix{std::data(number), static_cast<size_t>(last - std::data(number))};
+    auto text = roq::logging::get_error_text(error);
+    return dispatch(log_level, [&](auto out, auto size) {
+      size_t length = {};
+      auto out_2 = append(out, size, length, site.header);
+      auto out_3 = append(out_2, size, length, text);
+      auto out_4 = append(out_3, size, length, suffix);
+      return vformat(out_4, size, length, fmt.str, fmt::make_format_args(args...));
+    });
+  });
+}
+
+// note! error must be captured by the caller (registering the site may change errno)
+template <typename Tag, size_t level, typename... Args>
 static void helper_system_error(roq::logging::Level log_level, int error, roq::format_str const &fmt, Args &&...args) {
+  auto &site = get_site<Tag>(log_level, level, roq::logging::Prefix::SYSTEM_ERROR, fmt);
+  helper_system_error_site(log_level, site, error, fmt, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+static void helper_kv_site(roq::logging::Level log_level, roq::logging::Site const &site, roq::format_str const &fmt, Args const &...args) {
+  static_assert((roq::logging::is_key_value<Args>::value && ...), "arguments must be created using kv()");
+  measure(log_level, [&]() {
+    return dispatch(log_level, [&](auto out, auto size) {
+      roq::logging::detail::Writer writer{out, size};
+      writer(site.header);
+      std::string_view event{std::data(fmt.str), std::size(fmt.str)};
+      roq::logging::detail::encode(writer, roq::logging::structured_encoding, event, args...);
+      return writer.length();
+    });
+  });
+}
+
+template <typename Tag, size_t level, typename... Args>
+static void helper_kv(roq::logging::Level log_level, roq::format_str const &fmt, Args const &...args) {
+  auto &site = get_site<Tag>(log_level, level, roq::logging::Prefix::DEFAULT, fmt);
+  helper_kv_site(log_level, site, fmt, args...);
+}
+
+// rate limiting (note! per-site state is held by the site registry)
+
+inline int64_t get_coarse_time() {
+  struct timespec time = {};
+  ::clock_gettime(CLOCK_MONOTONIC_COARSE, &time);  // note! vdso, low resolution (typically 1-4ms)
+  return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+template <size_t n>
+struct EveryN final {
+  static_assert(n > 0);
+  static constexpr bool RESUMES = true;
+  static bool check(roq::logging::Site const &site) { return (site.counter.fetch_add(1, std::memory_order_relaxed) % n) == 0; }
+};
+
+template <size_t milliseconds>
+struct Every final {
+  static constexpr bool RESUMES = true;
+  static bool check(roq::logging::Site const &site) {
+    auto now = get_coarse_time();
+    auto next = site.next.load(std::memory_order_relaxed);
+    if (now < next) [[likely]] {
+      return false;
+    }
+    // note! only one thread can win
+    return site.next.compare_exchange_strong(next, now + static_cast<int64_t>(milliseconds) * 1000000, std::memory_order_relaxed);
+  }
+};
+
+template <size_t n>
+struct FirstN final {
+  static constexpr bool RESUMES = false;  // note! suppressed messages are therefore not counted
+  static bool check(roq::logging::Site const &site) {
+    if (site.counter.load(std::memory_order_relaxed) >= n) [[likely]] {
+      return false;
+    }
+    return site.counter.fetch_add(1, std::memory_order_relaxed) < n;
+  }
+};
+
+// note! the check is done before any formatting
+template <typename Policy, typename Tag, size_t level, typename... Args>
+static void helper_rate_limited(roq::logging::Level log_level, roq::format_str const &fmt, Args &&...args) {
   using namespace std::literals;
-  auto &message = roq::logging::message_buffer;
-  message.clear();
-  fmt::format_to(std::back_inserter(message), "L{} {}:{}] {} [{}] "sv, level, fmt.file_name, fmt.line, std::strerror(error), error);
-  fmt::vformat_to(std::back_inserter(message), fmt.str, fmt::make_format_args(args...));
-  roq::logging::Handler::get_instance()(log_level, message);
+  auto &site = get_site<Tag>(log_level, level, roq::logging::Prefix::DEFAULT, fmt);
+  if (!Policy::check(site)) {
+    if constexpr (Policy::RESUMES) {
+      site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    }
+    return;
+  }
+  if (site.suppressed.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+    auto suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+    dispatch(log_level, [&](auto out, auto size) {
+      size_t length = {};
+      auto out_2 = append(out, size, length, site.header);
+      return vformat(out_2, size, length, "*** SUPPRESSED {} MESSAGE(S) ***"sv, fmt::make_format_args(suppressed));
+    });
+  }
+  helper_site(log_level, site, fmt, std::forward<Args>(args)...);
 }
+
+template <roq::logging::Level log_level, typename Policy, std::size_t level, typename Tag>
+struct rate_limited final {
+  template <typename... Args>
+  constexpr rate_limited([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
+    if constexpr (is_enabled<log_level, level>) {
+      if constexpr (level > 0) {
+        if (!is_verbose<Tag>(log_level, level, roq::logging::Prefix::DEFAULT, fmt)) [[likely]] {
+          return;
+        }
+      }
+      helper_rate_limited<Policy, Tag, level>(log_level, fmt, std::forward<Args>(args)...);
+    }
+  }
+};
 }  // namespace detail
 
 // info
 
-template <std::size_t level = 0>
+template <std::size_t level = 0, typename Tag = decltype([] {})>
 struct info final {
   template <typename... Args>
-  constexpr info(format_str const &fmt, Args &&...args) {
-    if constexpr (level > 0) {
-      if (roq::logging::verbosity < level) [[likely]] {
-        return;
+  constexpr info([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::INFO, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::INFO, level, roq::logging::Prefix::DEFAULT, fmt)) [[likely]] {
+          return;
+        }
       }
+      detail::helper<Tag, level>(roq::logging::Level::INFO, fmt, std::forward<Args>(args)...);
     }
-    detail::helper<level>(roq::logging::Level::INFO, fmt, std::forward<Args>(args)...);
   }
 };
 
 // warn
 
-template <std::size_t level = 0>
+template <std::size_t level = 0, typename Tag = decltype([] {})>
 struct warn final {
   template <typename... Args>
-  constexpr warn(format_str const &fmt, Args &&...args) {
-    if constexpr (level > 0) {
-      if (roq::logging::verbosity < level) [[likely]] {
-        return;
+  constexpr warn([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::WARNING, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::WARNING, level, roq::logging::Prefix::DEFAULT, fmt)) [[likely]] {
+          return;
+        }
       }
+      detail::helper<Tag, level>(roq::logging::Level::WARNING, fmt, std::forward<Args>(args)...);
     }
-    detail::helper<level>(roq::logging::Level::WARNING, fmt, std::forward<Args>(args)...);
   }
 };
 
 // error
 
-template <std::size_t level = 0>
+template <std::size_t level = 0, typename Tag = decltype([] {})>
 struct error final {
   template <typename... Args>
-  constexpr error(format_str const &fmt, Args &&...args) {
-    if constexpr (level > 0) {
-      if (roq::logging::verbosity < level) [[likely]] {
-        return;
+  constexpr error([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::ERROR, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::ERROR, level, roq::logging::Prefix::DEFAULT, fmt)) [[likely]] {
+          return;
+        }
       }
+      detail::helper<Tag, level>(roq::logging::Level::ERROR, fmt, std::forward<Args>(args)...);
     }
-    detail::helper<level>(roq::logging::Level::ERROR, fmt, std::forward<Args>(args)...);
   }
 };
 
 // critical (will only abort if this is a debug build)
 
 #ifndef NDEBUG
-template <typename... Args>
+template <typename... Args, typename Tag = decltype([] {})>
 [[noreturn]] constexpr void critical(format_str const &fmt, Args &&...args) {
-  detail::helper<0>(roq::logging::Level::CRITICAL, fmt, std::forward<Args>(args)...);
+  detail::helper<Tag, 0>(roq::logging::Level::CRITICAL, fmt, std::forward<Args>(args)...);
+  roq::logging::Handler::drain_instance(roq::logging::drain_timeout, false);
   std::abort();
 }
 #else
-template <typename... Args>
+template <typename... Args, typename Tag = decltype([] {})>
 constexpr void critical(format_str const &fmt, Args &&...args) {
-  detail::helper<0>(roq::logging::Level::CRITICAL, fmt, std::forward<Args>(args)...);
+  detail::helper<Tag, 0>(roq::logging::Level::CRITICAL, fmt, std::forward<Args>(args)...);
 }
 #endif
 
-// fatal (will always abort)
+// fatal (will always abort, after having drained the queue)
 
-template <typename... Args>
+template <typename... Args, typename Tag = decltype([] {})>
 [[noreturn]] constexpr void fatal(format_str const &fmt, Args &&...args) {
-  detail::helper<0>(roq::logging::Level::CRITICAL, fmt, std::forward<Args>(args)...);
+  detail::helper<Tag, 0>(roq::logging::Level::CRITICAL, fmt, std::forward<Args>(args)...);
+  roq::logging::Handler::drain_instance(roq::logging::drain_timeout, false);
   std::abort();
 }
 
 // debug (no-op unless this is a debug build)
 
-template <std::size_t level = 0>
+template <std::size_t level = 0, typename Tag = decltype([] {})>
 struct debug final {
 #ifndef NDEBUG
   template <typename... Args>
-  constexpr debug(format_str const &fmt, Args &&...args) {
-    if constexpr (level > 0) {
-      if (roq::logging::verbosity < level) [[likely]] {
-        return;
+  constexpr debug([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::DEBUG, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::DEBUG, level, roq::logging::Prefix::DEBUG, fmt)) [[likely]] {
+          return;
+        }
       }
+      detail::helper_debug<Tag, level>(roq::logging::Level::DEBUG, fmt, std::forward<Args>(args)...);
     }
-    detail::helper_debug<level>(roq::logging::Level::DEBUG, fmt, std::forward<Args>(args)...);
   }
 #else
   template <typename... Args>
@@ -146,43 +458,133 @@ struct debug final {
 
 // debug_info (always debug if debug build, info if release build)
 
-template <std::size_t level = 0>
+template <std::size_t level = 0, typename Tag = decltype([] {})>
 struct debug_info final {
 #ifndef NDEBUG
   template <typename... Args>
-  constexpr debug_info(format_str const &fmt, Args &&...args) {
+  constexpr debug_info([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
     // note! always (disregard level)
-    detail::helper_debug<level>(roq::logging::Level::DEBUG, fmt, std::forward<Args>(args)...);
+    if constexpr (detail::is_enabled<roq::logging::Level::DEBUG, 0>) {
+      detail::helper_debug<Tag, level>(roq::logging::Level::DEBUG, fmt, std::forward<Args>(args)...);
+    }
   }
 #else
   template <typename... Args>
-  constexpr debug_info(format_str const &fmt, Args &&...args) {
-    if constexpr (level > 0) {
-      if (roq::logging::verbosity < level) [[likely]] {
-        return;
+  constexpr debug_info([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::INFO, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::INFO, level, roq::logging::Prefix::DEFAULT, fmt)) [[likely]] {
+          return;
+        }
       }
+      detail::helper<Tag, level>(roq::logging::Level::INFO, fmt, std::forward<Args>(args)...);
     }
-    detail::helper<level>(roq::logging::Level::INFO, fmt, std::forward<Args>(args)...);
   }
 #endif
 };
 
 // system_error
 
-template <std::size_t level = 0>
+template <std::size_t level = 0, typename Tag = decltype([] {})>
 struct system_error final {
   template <typename... Args>
-  constexpr system_error(format_str const &fmt, Args &&...args) {
-    if constexpr (level > 0) {
-      if (roq::logging::verbosity < level) [[likely]] {
-        return;
+  constexpr system_error([[maybe_unused]] format_str const &fmt, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::WARNING, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::WARNING, level, roq::logging::Prefix::SYSTEM_ERROR, fmt)) [[likely]] {
+          return;
+        }
+      }
+      static_assert(std::is_same_v<std::remove_cvref_t<decltype(errno)>, int>);
+      detail::helper_system_error<Tag, level>(roq::logging::Level::WARNING, errno, fmt, std::forward<Args>(args)...);
+    }
+  }
+};
+
+// structured (key/value) logging
+// - e.g. log::info_kv("order_ack"sv, log::kv("order_id", id), log::kv("latency_ns", ns))
+// - the event name must be a string literal
+
+using roq::logging::kv;
+
+template <std::size_t level = 0, typename Tag = decltype([] {})>
+struct info_kv final {
+  template <typename... Args>
+  constexpr info_kv([[maybe_unused]] format_str const &event, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::INFO, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::INFO, level, roq::logging::Prefix::DEFAULT, event)) [[likely]] {
+          return;
+        }
+      }
+      detail::helper_kv<Tag, level>(roq::logging::Level::INFO, event, args...);
+    }
+  }
+};
+
+template <std::size_t level = 0, typename Tag = decltype([] {})>
+struct warn_kv final {
+  template <typename... Args>
+  constexpr warn_kv([[maybe_unused]] format_str const &event, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::WARNING, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::WARNING, level, roq::logging::Prefix::DEFAULT, event)) [[likely]] {
+          return;
+        }
       }
+      detail::helper_kv<Tag, level>(roq::logging::Level::WARNING, event, args...);
     }
-    static_assert(std::is_same_v<std::remove_cvref_t<decltype(errno)>, int>);
-    detail::helper_system_error<level>(roq::logging::Level::WARNING, errno, fmt, std::forward<Args>(args)...);
   }
 };
 
+template <std::size_t level = 0, typename Tag = decltype([] {})>
+struct error_kv final {
+  template <typename... Args>
+  constexpr error_kv([[maybe_unused]] format_str const &event, [[maybe_unused]] Args &&...args) {
+    if constexpr (detail::is_enabled<roq::logging::Level::ERROR, level>) {
+      if constexpr (level > 0) {
+        if (!detail::is_verbose<Tag>(roq::logging::Level::ERROR, level, roq::logging::Prefix::DEFAULT, event)) [[likely]] {
+          return;
+        }
+      }
+      detail::helper_kv<Tag, level>(roq::logging::Level::ERROR, event, args...);
+    }
+  }
+};
+
+// rate limiting
+// - every_n: log the first and then every n'th message
+// - every: log at most once per interval (milliseconds)
+// - first_n: only log the first n messages (the suppressed messages are not reported, logging never resumes)
+// note! every_n and every log the number of suppressed messages (by the same call-site) when logging resumes
+
+template <std::size_t n, std::size_t level = 0, typename Tag = decltype([] {})>
+using info_every_n = detail::rate_limited<roq::logging::Level::INFO, detail::EveryN<n>, level, Tag>;
+
+template <std::size_t n, std::size_t level = 0, typename Tag = decltype([] {})>
+using warn_every_n = detail::rate_limited<roq::logging::Level::WARNING, detail::EveryN<n>, level, Tag>;
+
+template <std::size_t n, std::size_t level = 0, typename Tag = decltype([] {})>
+using error_every_n = detail::rate_limited<roq::logging::Level::ERROR, detail::EveryN<n>, level, Tag>;
+
+template <std::size_t milliseconds, std::size_t level = 0, typename Tag = decltype([] {})>
+using info_every = detail::rate_limited<roq::logging::Level::INFO, detail::Every<milliseconds>, level, Tag>;
+
+template <std::size_t milliseconds, std::size_t level = 0, typename Tag = decltype([] {})>
+using warn_every = detail::rate_limited<roq::logging::Level::WARNING, detail::Every<milliseconds>, level, Tag>;
+
+template <std::size_t milliseconds, std::size_t level = 0, typename Tag = decltype([] {})>
+using error_every = detail::rate_limited<roq::logging::Level::ERROR, detail::Every<milliseconds>, level, Tag>;
+
+template <std::size_t n, std::size_t level = 0, typename Tag = decltype([] {})>
+using info_first_n = detail::rate_limited<roq::logging::Level::INFO, detail::FirstN<n>, level, Tag>;
+
+template <std::size_t n, std::size_t level = 0, typename Tag = decltype([] {})>
+using warn_first_n = detail::rate_limited<roq::logging::Level::WARNING, detail::FirstN<n>, level, Tag>;
+
+template <std::size_t n, std::size_t level = 0, typename Tag = decltype([] {})>
+using error_first_n = detail::rate_limited<roq::logging::Level::ERROR, detail::FirstN<n>, level, Tag>;
+
 }  // namespace log
 
 struct print final {
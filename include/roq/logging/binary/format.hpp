@@ -0,0 +1,110 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace roq {
+namespace logging {
+namespace binary {
+
+// compact binary log file format
+// - all integers are LEB128 varints (signed integers are zigzag encoded)
+// - strings are length-prefixed (varint) and not null-terminated
+// - a file is a sequence of frames, each starting with a tag
+// - HEADER (re)starts a file: call-site ids and timestamp deltas are only valid until the next HEADER
+// - site ids are the registry indices (not necessarily contiguous), the stable id is the same across processes
+//
+// HEADER   : tag, magic, version, base timestamp (ns), metadata count, metadata (key, value)...
+// SITE     : tag, site id, stable id, verbosity, prefix, file name, line, format string
+// RECORD   : tag, level, site id, timestamp delta (signed), thread id, [error], argument count, arguments...
+// TEXT     : tag, level, site id (0 = none), timestamp delta (signed), thread id, [error], text
+//
+// note! TEXT is used when arguments can't be encoded, the text is then the formatted message
+// - with site: without the prefix
+// - without site: including the prefix
+
+static constexpr std::string_view const MAGIC = "ROQLOG";
+static constexpr uint8_t const VERSION = 1;
+
+// note! 0 is never used (zero-filled memory is the end of data)
+enum class Tag : uint8_t {
+  HEADER = 1,
+  SITE = 2,
+  RECORD = 3,
+  TEXT = 4,
+};
+
+enum class Type : uint8_t {
+  BOOL = 1,
+  CHAR = 2,
+  INT = 3,
+  UINT = 4,
+  FLOAT = 5,
+  DOUBLE = 6,
+};
+
+// note! other character types are excluded because they are formatted as characters
+template <typename T>
+inline constexpr bool is_encodable_v =
+    std::is_same_v<T, bool> || std::is_same_v<T, char> || std::is_same_v<T, float> || std::is_same_v<T, double> ||
+    (std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t) && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> &&
+     !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>);
+
+inline void encode_varint(std::string &buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+inline void encode_signed(std::string &buffer, int64_t value) {
+  encode_varint(buffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+inline void encode_string(std::string &buffer, std::string_view const &value) {
+  encode_varint(buffer, std::size(value));
+  buffer.append(value);
+}
+
+template <typename T>
+inline void encode_raw(std::string &buffer, T value) {
+  static_assert(std::endian::native == std::endian::little);
+  char tmp[sizeof(T)];
+  std::memcpy(tmp, &value, sizeof(T));
+  buffer.append(tmp, sizeof(T));
+}
+
+template <typename T>
+requires is_encodable_v<T>
+inline void encode_value(std::string &buffer, T value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    buffer.push_back(static_cast<char>(Type::BOOL));
+    buffer.push_back(value ? 1 : 0);
+  } else if constexpr (std::is_same_v<T, char>) {
+    buffer.push_back(static_cast<char>(Type::CHAR));
+    buffer.push_back(value);
+  } else if constexpr (std::is_same_v<T, float>) {
+    buffer.push_back(static_cast<char>(Type::FLOAT));
+    encode_raw(buffer, value);
+  } else if constexpr (std::is_same_v<T, double>) {
+    buffer.push_back(static_cast<char>(Type::DOUBLE));
+    encode_raw(buffer, value);
+  } else if constexpr (std::is_signed_v<T>) {
+    buffer.push_back(static_cast<char>(Type::INT));
+    encode_signed(buffer, value);
+  } else {
+    buffer.push_back(static_cast<char>(Type::UINT));
+    encode_varint(buffer, value);
+  }
+}
+
+}  // namespace binary
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,108 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "roq/logging/error.hpp"
+#include "roq/logging/site.hpp"
+
+#include "roq/logging/binary/format.hpp"
+
+namespace roq {
+namespace logging {
+
+// deferred formatting
+// - arguments are copied at the call-site and formatted by the backend thread
+// - the call-site (file name, line, format string) is referenced through the site registry
+// - only types which can safely outlive the call-site may be deferred
+// - pointers, std::string_view, std::span, etc. are excluded because they may reference memory owned by the caller
+// - specialize is_deferrable for your own (trivially copyable, self-contained) types
+
+template <typename T>
+struct is_deferrable : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+
+template <typename Rep, typename Period>
+struct is_deferrable<std::chrono::duration<Rep, Period>> : std::is_arithmetic<Rep> {};
+
+// note! queue records are only guaranteed to be 8 byte aligned
+template <typename T>
+inline constexpr bool is_deferrable_v = is_deferrable<T>::value && std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && alignof(T) <= 8;
+
+// note! type-erased access to the arguments captured at the call-site (all functions are called from the backend thread)
+struct Codec final {
+  struct Description final {
+    Site const *site = nullptr;
+    int error = {};
+  };
+
+  Description (*describe)(std::span<std::byte const> const &);
+  void (*format)(std::span<std::byte const> const &, std::string &message, bool prefix);
+  bool (*encode)(std::span<std::byte const> const &, std::string &buffer);  // note! returns false if any argument can't be encoded
+};
+
+namespace detail {
+template <typename... Args>
+struct Deferred final {
+  Site const *site = nullptr;
+  int error = {};
+  std::tuple<Args...> args;
+};
+
+template <typename... Args>
+Codec::Description describe_deferred(std::span<std::byte const> const &buffer) {
+  auto &deferred = *reinterpret_cast<Deferred<Args...> const *>(std::data(buffer));
+  return {
+      .site = deferred.site,
+      .error = deferred.error,
+  };
+}
+
+template <typename... Args>
+void format_deferred(std::span<std::byte const> const &buffer, std::string &message, bool include_prefix) {
+  using namespace std::literals;
+  auto &deferred = *reinterpret_cast<Deferred<Args...> const *>(std::data(buffer));
+  auto &site = *deferred.site;
+  auto out = std::back_inserter(message);
+  if (include_prefix) {
+    message.append(site.header);
+    if (site.prefix == Prefix::SYSTEM_ERROR) {
+      fmt::format_to(out, "{} [{}] "sv, get_error_text(deferred.error), deferred.error);
+    }
+  }
+  fmt::string_view str{std::data(site.format), std::size(site.format)};
+  std::apply([&](auto const &...args) { fmt::vformat_to(out, str, fmt::make_format_args(args...)); }, deferred.args);
+}
+
+template <typename... Args>
+bool encode_deferred(std::span<std::byte const> const &buffer, std::string &result) {
+  if constexpr ((binary::is_encodable_v<Args> && ...)) {
+    auto &deferred = *reinterpret_cast<Deferred<Args...> const *>(std::data(buffer));
+    binary::encode_varint(result, sizeof...(Args));
+    std::apply([&](auto const &...args) { (binary::encode_value(result, args), ...); }, deferred.args);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+template <typename... Args>
+inline constexpr Codec CODEC{
+    .describe = &describe_deferred<Args...>,
+    .format = &format_deferred<Args...>,
+    .encode = &encode_deferred<Args...>,
+};
+}  // namespace detail
+
+}  // namespace logging
+}  // namespace roq
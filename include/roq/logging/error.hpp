@@ -0,0 +1,224 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace roq {
+namespace logging {
+
+// errno to text
+// - constant table (same text as strerror for the Linux error numbers), no locale and no shared buffer
+// - "Unknown error {error}" if not in the table (same as strerror)
+// - thread-safe and async-signal-safe
+
+namespace detail {
+// note! indexed by errno (fixed size, the last Linux error number is EHWPOISON)
+inline constexpr size_t const ERROR_TEXT_SIZE = 134;
+
+inline constexpr std::array<std::string_view, ERROR_TEXT_SIZE> const ERROR_TEXT{
+    "Success",
+    "Operation not permitted",                            // EPERM
+    "No such file or directory",                          // ENOENT
+    "No such process",                                    // ESRCH
+    "Interrupted system call",                            // EINTR
+    "Input/output error",                                 // EIO
+    "No such device or address",                          // ENXIO
+    "Argument list too long",                             // E2BIG
+    "Exec format error",                                  // ENOEXEC
+    "Bad file descriptor",                                // EBADF
+    "No child processes",                                 // ECHILD
+    "Resource temporarily unavailable",                   // EAGAIN
+    "Cannot allocate memory",                             // ENOMEM
+    "Permission denied",                                  // EACCES
+    "Bad address",                                        // EFAULT
+    "Block device required",                              // ENOTBLK
+    "Device or resource busy",                            // EBUSY
+    "File exists",                                        // EEXIST
+    "Invalid cross-device link",                          // EXDEV
+    "No such device",                                     // ENODEV
+    "Not a directory",                                    // ENOTDIR
+    "Is a directory",                                     // EISDIR
+    "Invalid argument",                                   // EINVAL
+    "Too many open files in system",                      // ENFILE
+    "Too many open files",                                // EMFILE
+    "Inappropriate ioctl for device",                     // ENOTTY
+    "Text file busy",                                     // ETXTBSY
+    "File too large",                                     // EFBIG
+    "No space left on device",                            // ENOSPC
+    "Illegal seek",                                       // ESPIPE
+    "Read-only file system",                              // EROFS
+    "Too many links",                                     // EMLINK
+    "Broken pipe",                                        // EPIPE
+    "Numerical argument out of domain",                   // EDOM
+    "Numerical result out of range",                      // ERANGE
+    "Resource deadlock avoided",                          // EDEADLOCK
+    "File name too long",                                 // ENAMETOOLONG
+    "No locks available",                                 // ENOLCK
+    "Function not implemented",                           // ENOSYS
+    "Directory not empty",                                // ENOTEMPTY
+    "Too many levels of symbolic links",                  // ELOOP
+    "Unknown error 41",
+    "No message of desired type",                         // ENOMSG
+    "Identifier removed",                                 // EIDRM
+    "Channel number out of range",                        // ECHRNG
+    "Level 2 not synchronized",                           // EL2NSYNC
+    "Level 3 halted",                                     // EL3HLT
+    "Level 3 reset",                                      // EL3RST
+    "Link number out of range",                           // ELNRNG
+    "Protocol driver not attached",                       // EUNATCH
+    "No CSI structure available",                         // ENOCSI
+    "Level 2 halted",                                     // EL2HLT
+    "Invalid exchange",                                   // EBADE
+    "Invalid request descriptor",                         // EBADR
+    "Exchange full",                                      // EXFULL
+    "No anode",                                           // ENOANO
+    "Invalid request code",                               // EBADRQC
+    "Invalid slot",                                       // EBADSLT
+    "Unknown error 58",
+    "Bad font file format",                               // EBFONT
+    "Device not a stream",                                // ENOSTR
+    "No data available",                                  // ENODATA
+    "Timer expired",                                      // ETIME
+    "Out of streams resources",                           // ENOSR
+    "Machine is not on the network",                      // ENONET
+    "Package not installed",                              // ENOPKG
+    "Object is remote",                                   // EREMOTE
+    "Link has been severed",                              // ENOLINK
+    "Advertise error",                                    // EADV
+    "Srmount error",                                      // ESRMNT
+    "Communication error on send",                        // ECOMM
+    "Protocol error",                                     // EPROTO
+    "Multihop attempted",                                 // EMULTIHOP
+    "RFS specific error",                                 // EDOTDOT
+    "Bad message",                                        // EBADMSG
+    "Value too large for defined data type",              // EOVERFLOW
+    "Name not unique on network",                         // ENOTUNIQ
+    "File descriptor in bad state",                       // EBADFD
+    "Remote address changed",                             // EREMCHG
+    "Can not access a needed shared library",             // ELIBACC
+    "Accessing a corrupted shared library",               // ELIBBAD
+    ".lib section in a.out corrupted",                    // ELIBSCN
+    "Attempting to link in too many shared libraries",    // ELIBMAX
+    "Cannot exec a shared library directly",              // ELIBEXEC
+    "Invalid or incomplete multibyte or wide character",  // EILSEQ
+    "Interrupted system call should be restarted",        // ERESTART
+    "Streams pipe error",                                 // ESTRPIPE
+    "Too many users",                                     // EUSERS
+    "Socket operation on non-socket",                     // ENOTSOCK
+    "Destination address required",                       // EDESTADDRREQ
+    "Message too long",                                   // EMSGSIZE
+    "Protocol wrong type for socket",                     // EPROTOTYPE
+    "Protocol not available",                             // ENOPROTOOPT
+    "Protocol not supported",                             // EPROTONOSUPPORT
+    "Socket type not supported",                          // ESOCKTNOSUPPORT
+    "Operation not supported",                            // ENOTSUP
+    "Protocol family not supported",                      // EPFNOSUPPORT
+    "Address family not supported by protocol",           // EAFNOSUPPORT
+    "Address already in use",                             // EADDRINUSE
+    "Cannot assign requested address",                    // EADDRNOTAVAIL
+    "Network is down",                                    // ENETDOWN
+    "Network is unreachable",                             // ENETUNREACH
+    "Network dropped connection on reset",                // ENETRESET
+    "Software caused connection abort",                   // ECONNABORTED
+    "Connection reset by peer",                           // ECONNRESET
+    "No buffer space available",                          // ENOBUFS
+    "Transport endpoint is already connected",            // EISCONN
+    "Transport endpoint is not connected",                // ENOTCONN
+    "Cannot send after transport endpoint shutdown",      // ESHUTDOWN
+    "Too many references: cannot splice",                 // ETOOMANYREFS
+    "Connection timed out",                               // ETIMEDOUT
+    "Connection refused",                                 // ECONNREFUSED
+    "Host is down",                                       // EHOSTDOWN
+    "No route to host",                                   // EHOSTUNREACH
+    "Operation already in progress",                      // EALREADY
+    "Operation now in progress",                          // EINPROGRESS
+    "Stale file handle",                                  // ESTALE
+    "Structure needs cleaning",                           // EUCLEAN
+    "Not a XENIX named type file",                        // ENOTNAM
+    "No XENIX semaphores available",                      // ENAVAIL
+    "Is a named type file",                               // EISNAM
+    "Remote I/O error",                                   // EREMOTEIO
+    "Disk quota exceeded",                                // EDQUOT
+    "No medium found",                                    // ENOMEDIUM
+    "Wrong medium type",                                  // EMEDIUMTYPE
+    "Operation canceled",                                 // ECANCELED
+    "Required key not available",                         // ENOKEY
+    "Key has expired",                                    // EKEYEXPIRED
+    "Key has been revoked",                               // EKEYREVOKED
+    "Key was rejected by service",                        // EKEYREJECTED
+    "Owner died",                                         // EOWNERDEAD
+    "State not recoverable",                              // ENOTRECOVERABLE
+    "Operation not possible due to RF-kill",              // ERFKILL
+    "Memory page has hardware error",                     // EHWPOISON
+};
+
+static_assert(!std::empty(ERROR_TEXT.back()));  // note! all initialized
+
+#if defined(__linux__)
+static_assert(EHWPOISON == (ERROR_TEXT_SIZE - 1));
+#endif
+}  // namespace detail
+
+// note! value type (the text of an unknown error is formatted into the object itself)
+struct ErrorText final {
+  constexpr explicit ErrorText(int error) {
+    using namespace std::literals;
+    if (error >= 0 && static_cast<size_t>(error) < std::size(detail::ERROR_TEXT)) [[likely]] {
+      text_ = detail::ERROR_TEXT[error];
+      return;
+    }
+    auto prefix = "Unknown error "sv;
+    auto out = std::copy(std::begin(prefix), std::end(prefix), std::begin(buffer_));
+    auto value = static_cast<int64_t>(error);
+    if (value < 0) {
+      *out++ = '-';
+      value = -value;
+    }
+    std::array<char, 16> digits = {};
+    size_t count = {};
+    do {
+      digits[count++] = static_cast<char>('0' + (value % 10));
+      value /= 10;
+    } while (value != 0);
+    while (count > 0) {
+      *out++ = digits[--count];
+    }
+    length_ = static_cast<size_t>(out - std::begin(buffer_));
+  }
+
+  constexpr operator std::string_view() const {
+    if (std::data(text_) != nullptr) [[likely]] {
+      return text_;
+    }
+    return {std::data(buffer_), length_};
+  }
+
+ private:
+  std::string_view text_;
+  std::array<char, 32> buffer_ = {};
+  size_t length_ = {};
+};
+
+constexpr ErrorText get_error_text(int error) {
+  return ErrorText{error};
+}
+
+}  // namespace logging
+}  // namespace roq
+
+template <>
+struct fmt::formatter<roq::logging::ErrorText> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(roq::logging::ErrorText const &value, format_context &context) const {
+    using namespace std::literals;
+    return fmt::format_to(context.out(), "{}"sv, static_cast<std::string_view>(value));
+  }
+};
@@ -7,6 +7,7 @@
 #include <string_view>
 
 #include "roq/logging/handler.hpp"
+#include "roq/logging/metadata.hpp"
 #include "roq/logging/settings.hpp"
 
 namespace roq {
@@ -14,6 +15,7 @@ namespace logging {
 
 struct ROQ_PUBLIC Factory final {
   static std::unique_ptr<Handler> create(std::string_view const &type, Settings const &);
+  static std::unique_ptr<Handler> create(std::string_view const &type, Settings const &, Metadata const &);
 };
 
 }  // namespace logging
@@ -4,6 +4,9 @@
 
 #include "roq/compat.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <span>
 #include <string_view>
 
 #include "roq/logging/level.hpp"
@@ -11,6 +14,9 @@
 namespace roq {
 namespace logging {
 
+struct Codec;
+struct Stats;
+
 struct ROQ_PUBLIC Handler {
   Handler();
 
@@ -21,10 +27,48 @@ struct ROQ_PUBLIC Handler {
 
   virtual void operator()(Level, std::string_view const &message) = 0;
 
+  // two-phase (optional)
+  // - only used if the handler has opted in (see constructor)
+  // - reserve returns memory owned by the handler, empty means not supported (caller must then use operator())
+  // - a non-empty reserve must always be followed by commit (length 0 will discard)
+  virtual std::span<char> reserve(Level);
+  virtual void commit(Level, size_t length);
+
+  // deferred formatting (optional)
+  // - only used if the handler has opted in (see constructor)
+  // - reserve_deferred returns memory for the arguments captured at the call-site, empty means not supported (or not enabled)
+  // - codec will later be used from the backend thread
+  // - a non-empty reserve_deferred must always be followed by commit
+  virtual std::span<std::byte> reserve_deferred(Level, Codec const &, size_t length);
+
+  // metrics
+  // - snapshot, safe to call from any thread
+  // - the default implementation only includes the producer counters
+  virtual Stats get_stats() const;
+
+  // drain (optional)
+  // - wait until messages already enqueued have been written and flushed
+  // - used when the process is about to terminate (fatal, failure signal handler)
+  // - bounded by timeout, returns false on timeout (or if not possible)
+  // - signal means called from a signal handler: must then be async-signal-safe (no locks, no allocation)
+  virtual bool drain(std::chrono::nanoseconds timeout, bool signal);
+
+  // note! non-virtual, lets the caller skip reserve (and format straight into the message buffer)
+  bool is_two_phase() const { return two_phase_; }
+
   static Handler &get_instance() { return *INSTANCE; }
 
+  // note! does nothing if no handler has been created
+  static bool drain_instance(std::chrono::nanoseconds timeout, bool signal);
+
+ protected:
+  // note! handlers supporting two-phase and/or deferred formatting must opt in
+  explicit Handler(bool two_phase);
+
  private:
   static Handler *INSTANCE;
+
+  bool const two_phase_;
 };
 
 }  // namespace logging
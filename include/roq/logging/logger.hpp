@@ -4,6 +4,8 @@
 
 #include "roq/compat.hpp"
 
+#include <memory>
+
 #include "roq/args/parser.hpp"
 
 #include "roq/logging/handler.hpp"
@@ -12,12 +14,19 @@
 namespace roq {
 namespace logging {
 
+struct Control;
+
 // note! should only be used once
 struct ROQ_PUBLIC Logger final {
   Logger(args::Parser const &, logging::Settings const &, bool stacktrace = true);
 
   Logger(Logger const &) = delete;
   Logger(Logger &&) = delete;
+
+  ~Logger();
+
+ private:
+  std::unique_ptr<Control> control_;
 };
 
 }  // namespace logging
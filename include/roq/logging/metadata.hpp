@@ -0,0 +1,23 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <string_view>
+
+namespace roq {
+namespace logging {
+
+// note! build information, e.g. used for the header of binary log files
+struct Metadata final {
+  std::string_view package_name;
+  std::string_view host;
+  std::string_view build_version;
+  std::string_view build_number;
+  std::string_view build_type;
+  std::string_view git_hash;
+  std::string_view compile_date;
+  std::string_view compile_time;
+};
+
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,71 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include "roq/logging/level.hpp"
+
+namespace roq {
+namespace logging {
+
+struct Stats;
+
+// producer metrics (used by the call-site, see roq::logging::metrics)
+// - latency is the time spent formatting and enqueuing, bucket i counts [2^(i-1), 2^i) nanoseconds (last bucket is open-ended)
+
+namespace detail {
+// note! per producer thread (no contention), aggregated when reading
+// - only written by the owning thread (relaxed atomics so any thread can read)
+// - registered on first use, the counters are retained when the thread terminates
+struct ROQ_PUBLIC Metrics final {
+  static constexpr size_t const LEVELS = magic_enum::enum_count<Level>();
+  static constexpr size_t const LATENCY_BUCKETS = 32;
+
+  Metrics();
+
+  Metrics(Metrics const &) = delete;
+
+  ~Metrics();
+
+  static uint64_t now() {
+    struct timespec time = {};
+    ::clock_gettime(CLOCK_MONOTONIC, &time);  // note! vdso
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+  }
+
+  void operator()(Level level, size_t length, uint64_t latency) {
+    auto index = static_cast<size_t>(level);
+    add(messages[index], 1);
+    add(bytes[index], length);
+    auto bucket = std::min<size_t>(std::bit_width(latency), LATENCY_BUCKETS - 1);
+    add(this->latency[bucket], 1);
+  }
+
+  // note! all producer threads (including those which have terminated)
+  static void get(Stats &);
+
+  std::array<std::atomic<uint64_t>, LEVELS> messages = {};
+  std::array<std::atomic<uint64_t>, LEVELS> bytes = {};
+  std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> latency = {};
+
+ private:
+  // note! single writer (no read-modify-write)
+  static void add(std::atomic<uint64_t> &value, uint64_t delta) { value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed); }
+};
+
+extern ROQ_PUBLIC thread_local Metrics producer_metrics;
+}  // namespace detail
+
+}  // namespace logging
+}  // namespace roq
@@ -18,11 +18,35 @@ struct Log final {
   std::string_view pattern;
   std::chrono::nanoseconds flush_freq = {};
   std::string_view path;
-  uint32_t max_size = {};
+  uint64_t max_size = {};
   uint32_t max_files = {};
   bool rotate_on_open = {};
   std::string_view color;
   size_t verbosity = {};
+  std::string_view vmodule;  // note! pattern=N,...
+  bool verbosity_signals = {};  // note! SIGUSR1 (increment) and SIGUSR2 (decrement)
+  std::string_view control_file;
+  bool deferred = {};  // note! only supported by some handlers
+  std::string_view format;  // note! text (default) or binary (requires deferred)
+  bool mmap = {};  // note! only supported by some handlers
+  std::string_view compression;  // note! none (default) or zstd, only supported by some handlers
+  std::string_view compression_rotated;  // note! none (default) or zstd, only supported by some handlers
+  int32_t compression_level = {};
+  std::string_view thread_name;  // note! backend thread (applies to all asynchronous handlers)
+  std::string_view thread_affinity;  // note! cpu list, e.g. "1,3-4"
+  std::string_view thread_policy;  // note! other, batch, idle, fifo or rr
+  int32_t thread_priority = {};  // note! nice value (other, batch, idle) or real-time priority (fifo, rr)
+  std::string_view wait_strategy;  // note! sleep (default), spin, yield or block, only supported by some handlers
+  uint32_t wait_spin_count = {};  // note! busy-spin iterations before yielding
+  uint32_t wait_yield_count = {};  // note! yield iterations before sleeping (or blocking)
+  uint64_t queue_capacity = {};  // note! 0 means default, spdlog: messages, ring: bytes (per producer thread), shm: bytes
+  std::string_view overflow_policy;  // note! block (default), drop_newest, drop_oldest or drop_below_level
+  bool metrics = {};  // note! collect producer metrics (messages, bytes, latency)
+  std::chrono::nanoseconds metrics_freq = {};  // note! dump metrics every (0 means never), only supported by asynchronous handlers
+  std::string_view structured_format;  // note! logfmt (default) or json
+  std::chrono::nanoseconds drain_timeout = {};  // note! max time spent draining the queue when terminating (0 means default)
+  std::string_view sinks;  // note! type[@level][=path],..., only supported by some handlers
+  std::string_view shm_name;  // note! shared memory segment ("/dev/shm/{shm_name}"), only used by the shm handler
 };
 }  // namespace detail
 
@@ -48,7 +72,31 @@ struct fmt::formatter<roq::logging::detail::Log> {
         R"(max_files={}, )"
         R"(rotate_on_open={}, )"
         R"(color="{}", )"
-        R"(verbosity={})"
+        R"(verbosity={}, )"
+        R"(vmodule="{}", )"
+        R"(verbosity_signals={}, )"
+        R"(control_file="{}", )"
+        R"(deferred={}, )"
+        R"(format="{}", )"
+        R"(mmap={}, )"
+        R"(compression="{}", )"
+        R"(compression_rotated="{}", )"
+        R"(compression_level={}, )"
+        R"(thread_name="{}", )"
+        R"(thread_affinity="{}", )"
+        R"(thread_policy="{}", )"
+        R"(thread_priority={}, )"
+        R"(wait_strategy="{}", )"
+        R"(wait_spin_count={}, )"
+        R"(wait_yield_count={}, )"
+        R"(queue_capacity={}, )"
+        R"(overflow_policy="{}", )"
+        R"(metrics={}, )"
+        R"(metrics_freq={}, )"
+        R"(structured_format="{}", )"
+        R"(drain_timeout={}, )"
+        R"(sinks="{}", )"
+        R"(shm_name="{}")"
         R"(}})"sv,
         value.pattern,
         value.flush_freq,
@@ -57,7 +105,31 @@ struct fmt::formatter<roq::logging::detail::Log> {
         value.max_files,
         value.rotate_on_open,
         value.color,
-        value.verbosity);
+        value.verbosity,
+        value.vmodule,
+        value.verbosity_signals,
+        value.control_file,
+        value.deferred,
+        value.format,
+        value.mmap,
+        value.compression,
+        value.compression_rotated,
+        value.compression_level,
+        value.thread_name,
+        value.thread_affinity,
+        value.thread_policy,
+        value.thread_priority,
+        value.wait_strategy,
+        value.wait_spin_count,
+        value.wait_yield_count,
+        value.queue_capacity,
+        value.overflow_policy,
+        value.metrics,
+        value.metrics_freq,
+        value.structured_format,
+        value.drain_timeout,
+        value.sinks,
+        value.shm_name);
   }
 };
 
@@ -4,6 +4,9 @@
 
 #include "roq/compat.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <string>
 #include <thread>
 
 namespace roq {
@@ -11,8 +14,11 @@ namespace logging {
 
 extern ROQ_PUBLIC thread_local std::string message_buffer;
 
-extern ROQ_PUBLIC size_t verbosity;
+// note! may be changed at runtime (signals, control file)
+extern ROQ_PUBLIC std::atomic<size_t> verbosity;
 extern ROQ_PUBLIC bool terminal_color;
+extern ROQ_PUBLIC std::atomic<bool> metrics;  // note! collect producer metrics (messages, bytes, latency)
+extern ROQ_PUBLIC std::chrono::nanoseconds drain_timeout;  // note! max time spent draining the queue when terminating
 
 }  // namespace logging
 }  // namespace roq
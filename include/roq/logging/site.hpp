@@ -0,0 +1,109 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "roq/format_str.hpp"
+
+#include "roq/logging/level.hpp"
+
+namespace roq {
+namespace logging {
+
+// call-site registry
+// - each call-site is registered the first time it is executed and then remains valid for the life-time of the process
+// - lookup is lock-free (open addressing keyed by the address of the format string literal), registration is serialized
+// - the log functions cache the site (per call-site), the lookup is therefore only done the first time
+// - id is stable across processes (hash of level, verbosity, prefix, file name, line and format string)
+// - index is dense (registration order, starting from 1) and can be used to index per-site state
+// - header is the message prefix, formatted once when registering (the file name is trimmed to the basename)
+
+enum class Prefix : uint8_t {
+  DEFAULT,
+  DEBUG,
+  SYSTEM_ERROR,
+};
+
+struct ROQ_PUBLIC Site final {
+  uint64_t id = {};
+  uint32_t index = {};
+  Level level = {};
+  size_t verbosity = {};
+  Prefix prefix = {};
+  std::string_view file_name;
+  uint32_t line = {};
+  std::string_view format;
+  std::string_view header;  // note! "L{verbosity} {basename}:{line}] " (DEBUG adds "DEBUG: ", SYSTEM_ERROR is followed by the error)
+  // note! per-site state (rate limiting, vmodule)
+  mutable std::atomic<uint64_t> counter = {};
+  mutable std::atomic<int64_t> next = {};
+  mutable std::atomic<uint64_t> suppressed = {};
+  mutable std::atomic<uint64_t> vmodule = {};  // note! generation (high 32 bits), matched (bit 31) and verbosity (low 31 bits)
+};
+
+// note! snapshot of all sites registered so far (ordered by index)
+ROQ_PUBLIC std::vector<Site const *> get_sites();
+
+constexpr std::string_view get_basename(std::string_view const &file_name) {
+  auto separator = file_name.find_last_of('/');
+  if (separator == file_name.npos) {
+    return file_name;
+  }
+  return file_name.substr(separator + 1);
+}
+
+namespace detail {
+// note! open addressing (linear probing), grown (and rehashed) by register_site before the load factor exceeds 1/2
+// note! a table is never modified after being replaced (nor released), a reader may therefore use a stale table and only miss
+struct SiteTable final {
+  uint32_t shift = {};  // note! 64 - log2(size)
+  size_t mask = {};
+  std::atomic<Site const *> *slots = nullptr;
+};
+
+extern ROQ_PUBLIC std::atomic<SiteTable const *> site_table;
+
+ROQ_PUBLIC Site const &register_site(Level, size_t verbosity, Prefix, format_str const &);
+
+inline size_t get_site_hash(void const *format, uint32_t line, size_t verbosity, uint32_t shift) {
+  auto key = reinterpret_cast<uintptr_t>(format) ^ (uint64_t{line} << 40) ^ (uint64_t{verbosity} << 20);
+  return static_cast<size_t>((key * 0x9e3779b97f4a7c15) >> shift);  // note! top bits
+}
+
+inline bool is_same_site(Site const &site, Level level, size_t verbosity, Prefix prefix, format_str const &fmt) {
+  return std::data(site.format) == std::data(fmt.str) && std::data(site.file_name) == std::data(fmt.file_name) && site.line == fmt.line &&
+         site.level == level && site.verbosity == verbosity && site.prefix == prefix;
+}
+
+// note! terminates because the table always has empty slots
+inline Site const *find_site(SiteTable const &table, Level level, size_t verbosity, Prefix prefix, format_str const &fmt) {
+  auto hash = get_site_hash(std::data(fmt.str), static_cast<uint32_t>(fmt.line), verbosity, table.shift);
+  for (auto i = hash;; ++i) {
+    auto site = table.slots[i & table.mask].load(std::memory_order_acquire);
+    if (site == nullptr) {
+      return nullptr;
+    }
+    if (is_same_site(*site, level, verbosity, prefix, fmt)) [[likely]] {
+      return site;
+    }
+  }
+}
+}  // namespace detail
+
+inline Site const &get_site(Level level, size_t verbosity, Prefix prefix, format_str const &fmt) {
+  auto site = detail::find_site(*detail::site_table.load(std::memory_order_acquire), level, verbosity, prefix, fmt);
+  if (site != nullptr) [[likely]] {
+    return *site;
+  }
+  return detail::register_site(level, verbosity, prefix, fmt);
+}
+
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,46 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "roq/logging/level.hpp"
+
+#if defined(ROQ_LOGGING_STATIC_HANDLER_RING) || defined(ROQ_LOGGING_STATIC_HANDLER_SPDLOG) || defined(ROQ_LOGGING_STATIC_HANDLER_STANDARD)
+#define ROQ_LOGGING_STATIC_HANDLER
+#endif
+
+namespace roq {
+namespace logging {
+
+struct Codec;
+
+// handler bound at build time (ROQ_LOGGING_STATIC_HANDLER=ring|spdlog|standard)
+// - used by the log statements instead of the virtual Handler
+// - non-virtual and exported, the concrete (final) handler is called directly from inside the library (the queue is not exposed)
+// - falls back to the virtual Handler if the active handler is of another type (e.g. plugins and tests)
+// note! only defined when the library has been configured with ROQ_LOGGING_STATIC_HANDLER
+
+struct ROQ_PUBLIC StaticHandler final {
+  static constexpr bool is_two_phase() {
+#if defined(ROQ_LOGGING_STATIC_HANDLER_RING)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void operator()(Level, std::string_view const &message);
+
+  std::span<char> reserve(Level);
+  void commit(Level, size_t length);
+
+  std::span<std::byte> reserve_deferred(Level, Codec const &, size_t length);
+};
+
+}  // namespace logging
+}  // namespace roq
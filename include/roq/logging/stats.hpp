@@ -0,0 +1,100 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "roq/logging/metrics.hpp"
+
+namespace roq {
+namespace logging {
+
+// metrics
+// - producer counters (messages, bytes, latency) are collected by the call-site when enabled (see detail::Metrics)
+// - backend counters (queue depth, dropped, write and flush time) are collected by the handler
+
+struct Stats final {
+  static constexpr size_t const LEVELS = detail::Metrics::LEVELS;
+  static constexpr size_t const LATENCY_BUCKETS = detail::Metrics::LATENCY_BUCKETS;
+
+  std::array<uint64_t, LEVELS> messages = {};
+  std::array<uint64_t, LEVELS> bytes = {};
+  std::array<uint64_t, LEVELS> dropped = {};
+  uint64_t queue_depth = {};      // note! messages (spdlog) or bytes (ring)
+  uint64_t queue_depth_max = {};  // note! high-water mark
+  uint64_t write_count = {};
+  std::chrono::nanoseconds write_time = {};
+  uint64_t flush_count = {};
+  std::chrono::nanoseconds flush_time = {};
+  std::array<uint64_t, LATENCY_BUCKETS> latency = {};
+
+  // note! upper bound of the bucket containing the percentile (0.0 to 1.0)
+  std::chrono::nanoseconds get_latency(double percentile) const {
+    uint64_t total = {};
+    for (auto count : latency) {
+      total += count;
+    }
+    if (total == 0) {
+      return {};
+    }
+    auto target = static_cast<uint64_t>(static_cast<double>(total) * percentile);
+    uint64_t sum = {};
+    for (size_t i = 0; i < std::size(latency); ++i) {
+      sum += latency[i];
+      if (sum > target || sum == total) {
+        return std::chrono::nanoseconds{i == 0 ? int64_t{0} : (int64_t{1} << i) - 1};
+      }
+    }
+    return {};
+  }
+};
+
+}  // namespace logging
+}  // namespace roq
+
+template <>
+struct fmt::formatter<roq::logging::Stats> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(roq::logging::Stats const &value, format_context &context) const {
+    using namespace std::literals;
+    return fmt::format_to(
+        context.out(),
+        R"({{)"
+        R"(messages=[{}], )"
+        R"(bytes=[{}], )"
+        R"(dropped=[{}], )"
+        R"(queue_depth={}, )"
+        R"(queue_depth_max={}, )"
+        R"(write_count={}, )"
+        R"(write_time={}, )"
+        R"(flush_count={}, )"
+        R"(flush_time={}, )"
+        R"(latency_p50={}, )"
+        R"(latency_p99={}, )"
+        R"(latency_p999={}, )"
+        R"(latency_max={})"
+        R"(}})"sv,
+        fmt::join(value.messages, ", "sv),
+        fmt::join(value.bytes, ", "sv),
+        fmt::join(value.dropped, ", "sv),
+        value.queue_depth,
+        value.queue_depth_max,
+        value.write_count,
+        value.write_time,
+        value.flush_count,
+        value.flush_time,
+        value.get_latency(0.5),
+        value.get_latency(0.99),
+        value.get_latency(0.999),
+        value.get_latency(1.0));
+  }
+};
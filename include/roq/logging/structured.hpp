@@ -0,0 +1,215 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+namespace roq {
+namespace logging {
+
+// structured (key/value) logging
+// - fields are encoded straight into the message buffer (no heap allocation)
+// - keys must be string literals and are validated at compile-time (letters, digits, '_', '.' and '-')
+// - the encoding (logfmt or json) is selected at runtime and applies to the message (the prefix is unchanged)
+// - values: bool, integers and floating point are written as-is, everything else is written as an escaped string (using fmt::formatter)
+// note! values are referenced (not copied) and must outlive the log statement
+
+enum class Encoding : uint8_t {
+  LOGFMT,  // event=order_ack order_id=123 text="hello world"
+  JSON,    // {"event":"order_ack","order_id":123,"text":"hello world"}
+};
+
+extern ROQ_PUBLIC Encoding structured_encoding;  // note! should only be changed during initialization
+
+struct Key final {
+  template <size_t N>
+  consteval Key(char const (&value)[N]) : name{value, N - 1} {  // NOLINT(google-explicit-constructor)
+    static_assert(N > 1, "key can't be empty");
+    for (size_t i = 0; i < (N - 1); ++i) {
+      auto c = value[i];
+      auto valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.' || c == '-';
+      if (!valid) {
+        throw "invalid key";  // note! compile-time error
+      }
+    }
+  }
+
+  std::string_view const name;
+};
+
+template <typename T>
+struct KeyValue final {
+  std::string_view key;
+  T const &value;
+};
+
+template <typename T>
+constexpr auto kv(Key const &key, T const &value) {
+  return KeyValue<T>{key.name, value};
+}
+
+template <typename T>
+struct is_key_value : std::false_type {};
+
+template <typename T>
+struct is_key_value<KeyValue<T>> : std::true_type {};
+
+namespace detail {
+// note! bounded output, length keeps counting beyond size (same semantics as fmt::format_to_n)
+template <typename OutputIt>
+struct Writer final {
+  Writer(OutputIt out, size_t size) : out_{out}, size_{size} {}
+
+  size_t length() const { return length_; }
+
+  void operator()(char c) {
+    if (length_ < size_) [[likely]] {
+      *out_++ = c;
+    }
+    ++length_;
+  }
+
+  void operator()(std::string_view const &text) {
+    auto available = length_ < size_ ? (size_ - length_) : size_t{0};
+    auto count = std::min(std::size(text), available);
+    out_ = std::copy_n(std::data(text), count, out_);
+    length_ += std::size(text);
+  }
+
+  template <typename... Args>
+  void format(fmt::format_string<Args...> const &fmt, Args &&...args) {
+    auto available = length_ < size_ ? (size_ - length_) : size_t{0};
+    auto result = fmt::format_to_n(out_, available, fmt, std::forward<Args>(args)...);
+    out_ = result.out;
+    length_ += result.size;
+  }
+
+ private:
+  OutputIt out_;
+  size_t const size_;
+  size_t length_ = {};
+};
+
+// note! escapes while writing (json and logfmt share the escape rules for quoted strings)
+template <typename Writer>
+struct EscapeIterator final {
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
+
+  explicit EscapeIterator(Writer &writer) : writer_{&writer} {}
+
+  EscapeIterator &operator=(char c) {
+    auto &writer = *writer_;
+    switch (c) {
+      case '"':
+        writer(R"(\")");
+        break;
+      case '\\':
+        writer(R"(\\)");
+        break;
+      case '\n':
+        writer(R"(\n)");
+        break;
+      case '\r':
+        writer(R"(\r)");
+        break;
+      case '\t':
+        writer(R"(\t)");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          writer.format(R"(\u{:04x})", static_cast<unsigned>(c));
+        } else {
+          writer(c);
+        }
+    }
+    return *this;
+  }
+  EscapeIterator &operator*() { return *this; }
+  EscapeIterator &operator++() { return *this; }
+  EscapeIterator operator++(int) { return *this; }
+
+ private:
+  Writer *writer_;
+};
+
+template <typename T>
+inline constexpr bool is_number_v = (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>);
+
+inline bool requires_quotes(std::string_view const &text) {
+  if (std::empty(text)) {
+    return true;
+  }
+  for (auto c : text) {
+    if (static_cast<unsigned char>(c) <= ' ' || c == '=' || c == '"' || c == '\\') {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Writer>
+void encode_string(Writer &writer, Encoding encoding, std::string_view const &text) {
+  if (encoding == Encoding::LOGFMT && !requires_quotes(text)) {
+    writer(text);
+    return;
+  }
+  writer('"');
+  std::copy(std::begin(text), std::end(text), EscapeIterator{writer});
+  writer('"');
+}
+
+template <typename Writer, typename T>
+void encode_value(Writer &writer, Encoding encoding, T const &value) {
+  using value_type = std::remove_cvref_t<T>;
+  if constexpr (std::is_same_v<value_type, bool>) {
+    writer(value ? std::string_view{"true"} : std::string_view{"false"});
+  } else if constexpr (std::is_floating_point_v<value_type>) {
+    if (encoding == Encoding::JSON && !std::isfinite(value)) {
+      writer(std::string_view{"null"});
+    } else {
+      writer.format("{}", value);
+    }
+  } else if constexpr (is_number_v<value_type>) {
+    writer.format("{}", value);
+  } else if constexpr (std::is_convertible_v<T const &, std::string_view>) {
+    encode_string(writer, encoding, std::string_view{value});
+  } else if constexpr (std::is_same_v<value_type, char>) {
+    encode_string(writer, encoding, std::string_view{&value, 1});
+  } else {
+    writer('"');
+    fmt::format_to(EscapeIterator{writer}, "{}", value);
+    writer('"');
+  }
+}
+
+template <typename Writer, typename... Args>
+void encode(Writer &writer, Encoding encoding, std::string_view const &event, KeyValue<Args> const &...args) {
+  if (encoding == Encoding::JSON) {
+    writer(std::string_view{R"({"event":)"});
+    encode_string(writer, encoding, event);
+    ((writer(std::string_view{R"(,")"}), writer(args.key), writer(std::string_view{R"(":)"}), encode_value(writer, encoding, args.value)), ...);
+    writer('}');
+  } else {
+    writer(std::string_view{"event="});
+    encode_string(writer, encoding, event);
+    ((writer(' '), writer(args.key), writer('='), encode_value(writer, encoding, args.value)), ...);
+  }
+}
+}  // namespace detail
+
+}  // namespace logging
+}  // namespace roq
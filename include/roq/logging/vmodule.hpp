@@ -0,0 +1,54 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "roq/logging/level.hpp"
+#include "roq/logging/site.hpp"
+
+namespace roq {
+namespace logging {
+
+// per-module verbosity (glog style)
+// - comma separated list of pattern=N, the first matching pattern wins
+// - a matching pattern replaces the global verbosity (it may also lower it, e.g. noisy=0), other files use the global verbosity
+// - patterns are globs ('*' and '?') matched against the file name without directory and extension
+// - patterns containing '/' are instead matched against the full file name
+// - decisions are cached per call-site
+// - may be changed at runtime
+// note! cost: a call-site (verbosity N > 0) only compares with the global verbosity unless some pattern exists, it then reads the
+// decision cached by its site (the site itself is cached by the call-site, the registry is only probed the first time)
+
+// note! throws on invalid specification (the logger will print the error and exit when initializing)
+ROQ_PUBLIC void set_vmodule(std::string_view const &);
+
+namespace detail {
+extern ROQ_PUBLIC std::atomic<bool> has_vmodule;             // note! true if any pattern exists
+extern ROQ_PUBLIC std::atomic<uint32_t> vmodule_generation;  // note! incremented whenever the vmodule changes
+
+static constexpr uint64_t const VMODULE_MATCHED = uint64_t{1} << 31;
+static constexpr uint64_t const VMODULE_VERBOSITY = VMODULE_MATCHED - 1;
+
+ROQ_PUBLIC uint64_t update_vmodule(Site const &);
+
+// note! only called when some pattern exists, verbosity is the global verbosity
+inline bool is_vmodule_enabled(Site const &site, size_t level, size_t verbosity) {
+  auto cached = site.vmodule.load(std::memory_order_relaxed);
+  if ((cached >> 32) != vmodule_generation.load(std::memory_order_relaxed)) [[unlikely]] {
+    cached = update_vmodule(site);
+  }
+  if (cached & VMODULE_MATCHED) {
+    return (cached & VMODULE_VERBOSITY) >= level;
+  }
+  return verbosity >= level;
+}
+}  // namespace detail
+
+}  // namespace logging
+}  // namespace roq
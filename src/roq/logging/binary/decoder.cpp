@@ -0,0 +1,358 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/binary/decoder.hpp"
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include <cstring>
+#include <ctime>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/error.hpp"
+#include "roq/logging/site.hpp"
+
+#include "roq/logging/binary/format.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace binary {
+
+// === HELPERS ===
+
+namespace {
+bool read_byte(std::string_view &buffer, uint8_t &result) {
+  if (std::empty(buffer)) {
+    return false;
+  }
+  result = static_cast<uint8_t>(buffer[0]);
+  buffer.remove_prefix(1);
+  return true;
+}
+
+bool read_varint(std::string_view &buffer, uint64_t &result) {
+  result = {};
+  for (size_t shift = 0; shift < 64; shift += 7) {
+    uint8_t value = {};
+    if (!read_byte(buffer, value)) {
+      return false;
+    }
+    result |= static_cast<uint64_t>(value & 0x7f) << shift;
+    if ((value & 0x80) == 0) {
+      return true;
+    }
+  }
+  throw RuntimeError{"Invalid varint"sv};
+}
+
+bool read_signed(std::string_view &buffer, int64_t &result) {
+  uint64_t value = {};
+  if (!read_varint(buffer, value)) {
+    return false;
+  }
+  result = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  return true;
+}
+
+bool read_string(std::string_view &buffer, std::string_view &result) {
+  uint64_t length = {};
+  if (!read_varint(buffer, length) || std::size(buffer) < length) {
+    return false;
+  }
+  result = buffer.substr(0, length);
+  buffer.remove_prefix(length);
+  return true;
+}
+
+template <typename T>
+bool read_raw(std::string_view &buffer, T &result) {
+  if (std::size(buffer) < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&result, std::data(buffer), sizeof(T));
+  buffer.remove_prefix(sizeof(T));
+  return true;
+}
+
+bool read_value(std::string_view &buffer, fmt::dynamic_format_arg_store<fmt::format_context> &store) {
+  uint8_t type = {};
+  if (!read_byte(buffer, type)) {
+    return false;
+  }
+  switch (static_cast<Type>(type)) {
+    case Type::BOOL: {
+      uint8_t value = {};
+      if (!read_byte(buffer, value)) {
+        return false;
+      }
+      store.push_back(value != 0);
+      return true;
+    }
+    case Type::CHAR: {
+      uint8_t value = {};
+      if (!read_byte(buffer, value)) {
+        return false;
+      }
+      store.push_back(static_cast<char>(value));
+      return true;
+    }
+    case Type::INT: {
+      int64_t value = {};
+      if (!read_signed(buffer, value)) {
+        return false;
+      }
+      store.push_back(value);
+      return true;
+    }
+    case Type::UINT: {
+      uint64_t value = {};
+      if (!read_varint(buffer, value)) {
+        return false;
+      }
+      store.push_back(value);
+      return true;
+    }
+    case Type::FLOAT: {
+      float value = {};
+      if (!read_raw(buffer, value)) {
+        return false;
+      }
+      store.push_back(value);
+      return true;
+    }
+    case Type::DOUBLE: {
+      double value = {};
+      if (!read_raw(buffer, value)) {
+        return false;
+      }
+      store.push_back(value);
+      return true;
+    }
+  }
+  throw RuntimeError{"Unknown type: {}"sv, type};
+}
+
+// note! matching spdlog's short level names
+constexpr auto get_level_char(Level level) {
+  switch (level) {
+    using enum Level;
+    case DEBUG:
+      return 'D';
+    case INFO:
+      return 'I';
+    case WARNING:
+      return 'W';
+    case ERROR:
+      return 'E';
+    case CRITICAL:
+      return 'C';
+  }
+  return '?';
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Decoder::Decoder(Handler &handler) : handler_{handler} {
+}
+
+size_t Decoder::operator()(std::string_view const &buffer) {
+  auto remaining = buffer;
+  while (!std::empty(remaining)) {
+    if (remaining[0] == '\0' || end_) [[unlikely]] {
+      if (remaining.find_first_not_of('\0') != remaining.npos) {
+        throw RuntimeError{"Unexpected data after end (zero-filled)"sv};
+      }
+      end_ = true;
+      return std::size(buffer);
+    }
+    auto tmp = remaining;
+    uint8_t tag = {};
+    read_byte(tmp, tag);
+    auto complete = false;
+    switch (static_cast<Tag>(tag)) {
+      case Tag::HEADER:
+        complete = decode_header(tmp);
+        break;
+      case Tag::SITE:
+        complete = decode_site(tmp);
+        break;
+      case Tag::RECORD:
+        complete = decode_record(tmp, false);
+        break;
+      case Tag::TEXT:
+        complete = decode_record(tmp, true);
+        break;
+      default:
+        throw RuntimeError{"Unknown tag: {}"sv, tag};
+    }
+    if (!complete) {
+      break;
+    }
+    length_ += std::size(remaining) - std::size(tmp);
+    remaining = tmp;
+  }
+  return std::size(buffer) - std::size(remaining);
+}
+
+bool Decoder::decode_header(std::string_view &buffer) {
+  if (std::size(buffer) < (std::size(MAGIC) + 1)) {
+    return false;
+  }
+  if (buffer.substr(0, std::size(MAGIC)) != MAGIC) {
+    throw RuntimeError{"Invalid magic"sv};
+  }
+  buffer.remove_prefix(std::size(MAGIC));
+  uint8_t version = {};
+  read_byte(buffer, version);
+  if (version != VERSION) {
+    throw RuntimeError{"Unsupported version: {}"sv, version};
+  }
+  int64_t timestamp = {};
+  uint64_t count = {};
+  if (!read_signed(buffer, timestamp) || !read_varint(buffer, count)) {
+    return false;
+  }
+  std::vector<std::pair<std::string, std::string>> metadata;
+  for (size_t i = 0; i < count; ++i) {
+    std::string_view key, value;
+    if (!read_string(buffer, key) || !read_string(buffer, value)) {
+      return false;
+    }
+    metadata.emplace_back(key, value);
+  }
+  ready_ = true;
+  last_timestamp_ = std::chrono::nanoseconds{timestamp};
+  sites_.clear();
+  metadata_ = std::move(metadata);
+  handler_(metadata_);
+  return true;
+}
+
+bool Decoder::decode_site(std::string_view &buffer) {
+  uint64_t site_id = {}, id = {}, verbosity = {}, line = {};
+  uint8_t prefix = {};
+  std::string_view file_name, format;
+  if (!read_varint(buffer, site_id) || !read_varint(buffer, id) || !read_varint(buffer, verbosity) || !read_byte(buffer, prefix) ||
+      !read_string(buffer, file_name) || !read_varint(buffer, line) || !read_string(buffer, format)) {
+    return false;
+  }
+  if (!ready_) {
+    throw RuntimeError{"Missing header"sv};
+  }
+  if (site_id == 0) {
+    throw RuntimeError{"Unexpected site id: {}"sv, site_id};
+  }
+  sites_.insert_or_assign(
+      site_id,
+      Site{
+          .id = id,
+          .format = std::string{format},
+          .file_name = std::string{file_name},
+          .line = static_cast<uint32_t>(line),
+          .verbosity = verbosity,
+          .prefix = static_cast<Prefix>(prefix),
+      });
+  return true;
+}
+
+bool Decoder::decode_record(std::string_view &buffer, bool text) {
+  uint8_t level = {};
+  uint64_t site_id = {}, thread_id = {};
+  int64_t delta = {};
+  if (!read_byte(buffer, level) || !read_varint(buffer, site_id) || !read_signed(buffer, delta) || !read_varint(buffer, thread_id)) {
+    return false;
+  }
+  if (!ready_) {
+    throw RuntimeError{"Missing header"sv};
+  }
+  if (level > static_cast<uint8_t>(Level::CRITICAL)) {
+    throw RuntimeError{"Unknown level: {}"sv, level};
+  }
+  Site const *site = nullptr;
+  if (site_id != 0) {
+    auto iter = sites_.find(site_id);
+    if (iter == std::end(sites_)) {
+      throw RuntimeError{"Unknown site id: {}"sv, site_id};
+    }
+    site = &(*iter).second;
+  } else if (!text) {
+    throw RuntimeError{"Missing site id"sv};
+  }
+  int64_t error = {};
+  if (site != nullptr && (*site).prefix == Prefix::SYSTEM_ERROR) {
+    if (!read_signed(buffer, error)) {
+      return false;
+    }
+  }
+  std::string_view message;
+  fmt::dynamic_format_arg_store<fmt::format_context> store;
+  if (text) {
+    if (!read_string(buffer, message)) {
+      return false;
+    }
+  } else {
+    uint64_t count = {};
+    if (!read_varint(buffer, count)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (!read_value(buffer, store)) {
+        return false;
+      }
+    }
+  }
+  // note! frame is complete
+  auto timestamp = last_timestamp_ + std::chrono::nanoseconds{delta};
+  last_timestamp_ = timestamp;
+  line_.clear();
+  format_prefix(static_cast<Level>(level), timestamp, static_cast<uint32_t>(thread_id));
+  auto out = std::back_inserter(line_);
+  if (site != nullptr) {
+    // note! same as the call-site header
+    auto file_name = get_basename((*site).file_name);
+    switch ((*site).prefix) {
+      case Prefix::DEFAULT:
+        fmt::format_to(out, "L{} {}:{}] "sv, (*site).verbosity, file_name, (*site).line);
+        break;
+      case Prefix::DEBUG:
+        fmt::format_to(out, "L{} {}:{}] DEBUG: "sv, (*site).verbosity, file_name, (*site).line);
+        break;
+      case Prefix::SYSTEM_ERROR:
+        fmt::format_to(out, "L{} {}:{}] {} [{}] "sv, (*site).verbosity, file_name, (*site).line, get_error_text(static_cast<int>(error)), error);
+        break;
+    }
+  }
+  if (text) {
+    line_.append(message);
+  } else {
+    try {
+      fmt::vformat_to(out, (*site).format, store);
+    } catch (std::exception &e) {
+      fmt::format_to(out, R"( *** UNABLE TO FORMAT *** what="{}")"sv, e.what());
+    }
+  }
+  handler_(line_);
+  return true;
+}
+
+// note! glog style matching the default spdlog pattern "%L%m%d %T.%f %t "
+void Decoder::format_prefix(Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id) {
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timestamp);
+  if (seconds != last_second_) {
+    auto time = static_cast<std::time_t>(seconds.count());
+    struct tm tm = {};
+    ::localtime_r(&time, &tm);
+    std::strftime(std::data(date_time_), std::size(date_time_), "%m%d %H:%M:%S", &tm);
+    last_second_ = seconds;
+  }
+  auto nanos = (timestamp - seconds).count();
+  fmt::format_to(std::back_inserter(line_), "{}{}.{:09} {} "sv, get_level_char(level), std::data(date_time_), nanos, thread_id);
+}
+
+}  // namespace binary
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,75 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+#include "roq/logging/deferred.hpp"
+#include "roq/logging/level.hpp"
+
+namespace roq {
+namespace logging {
+namespace binary {
+
+// note! converts the binary format back to glog style text
+struct ROQ_PUBLIC Decoder final {
+  struct Handler {
+    virtual void operator()(std::vector<std::pair<std::string, std::string>> const &metadata) = 0;
+    virtual void operator()(std::string_view const &line) = 0;
+  };
+
+  explicit Decoder(Handler &);
+
+  Decoder(Decoder const &) = delete;
+
+  // note! returns the number of bytes consumed (an incomplete frame is left for the next call)
+  // note! zero-filled memory is the end of data (e.g. the preallocated tail of a memory-mapped file after a crash)
+  size_t operator()(std::string_view const &buffer);
+
+  // note! true when zero-filled memory has been seen
+  bool end() const { return end_; }
+
+  // note! bytes of complete frames decoded so far (excludes the zero-filled tail)
+  uint64_t get_length() const { return length_; }
+
+ protected:
+  bool decode_header(std::string_view &buffer);
+  bool decode_site(std::string_view &buffer);
+  bool decode_record(std::string_view &buffer, bool text);
+
+  void format_prefix(Level, std::chrono::nanoseconds timestamp, uint32_t thread_id);
+
+ private:
+  struct Site final {
+    uint64_t id = {};
+    std::string format;
+    std::string file_name;
+    uint32_t line = {};
+    size_t verbosity = {};
+    Prefix prefix = {};
+  };
+
+  Handler &handler_;
+  bool ready_ = {};
+  bool end_ = {};
+  uint64_t length_ = {};
+  std::chrono::nanoseconds last_timestamp_ = {};
+  std::unordered_map<uint64_t, Site> sites_;
+  std::vector<std::pair<std::string, std::string>> metadata_;
+  std::string line_;
+  std::chrono::seconds last_second_ = {};
+  std::array<char, 16> date_time_ = {};
+};
+
+}  // namespace binary
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,127 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/binary/encoder.hpp"
+
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "roq/logging/binary/format.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace binary {
+
+// === HELPERS ===
+
+namespace {
+auto create_metadata(auto &metadata) -> std::vector<std::pair<std::string, std::string>> {
+  return {
+      {"package_name"s, std::string{metadata.package_name}},
+      {"host"s, std::string{metadata.host}},
+      {"build_version"s, std::string{metadata.build_version}},
+      {"build_number"s, std::string{metadata.build_number}},
+      {"build_type"s, std::string{metadata.build_type}},
+      {"git_hash"s, std::string{metadata.git_hash}},
+      {"compile_date"s, std::string{metadata.compile_date}},
+      {"compile_time"s, std::string{metadata.compile_time}},
+      {"pid"s, fmt::format("{}"sv, ::getpid())},
+  };
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Encoder::Encoder(Metadata const &metadata) : metadata_{create_metadata(metadata)} {
+}
+
+void Encoder::reset() {
+  ready_ = false;
+  sites_.clear();
+}
+
+void Encoder::operator()(std::string &buffer, Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message) {
+  if (!ready_) [[unlikely]] {
+    encode_header(buffer, timestamp);
+  }
+  encode_common(buffer, Tag::TEXT, level, 0, timestamp, thread_id);
+  encode_string(buffer, message);
+}
+
+void Encoder::operator()(
+    std::string &buffer, Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id, Codec const &codec, std::span<std::byte const> const &payload) {
+  if (!ready_) [[unlikely]] {
+    encode_header(buffer, timestamp);
+  }
+  auto description = (*codec.describe)(payload);
+  auto site_id = get_site_id(buffer, description);
+  auto offset = std::size(buffer);
+  auto last_timestamp = last_timestamp_;
+  encode_common(buffer, Tag::RECORD, level, site_id, timestamp, thread_id);
+  if ((*description.site).prefix == Prefix::SYSTEM_ERROR) {
+    encode_signed(buffer, description.error);
+  }
+  if ((*codec.encode)(payload, buffer)) [[likely]] {
+    return;
+  }
+  // note! arguments can't be encoded, fall back to the formatted message (without prefix)
+  buffer.resize(offset);
+  last_timestamp_ = last_timestamp;
+  encode_common(buffer, Tag::TEXT, level, site_id, timestamp, thread_id);
+  if ((*description.site).prefix == Prefix::SYSTEM_ERROR) {
+    encode_signed(buffer, description.error);
+  }
+  text_.clear();
+  (*codec.format)(payload, text_, false);
+  encode_string(buffer, text_);
+}
+
+void Encoder::encode_header(std::string &buffer, std::chrono::nanoseconds timestamp) {
+  buffer.push_back(static_cast<char>(Tag::HEADER));
+  buffer.append(MAGIC);
+  buffer.push_back(static_cast<char>(VERSION));
+  encode_signed(buffer, timestamp.count());
+  encode_varint(buffer, std::size(metadata_));
+  for (auto &[key, value] : metadata_) {
+    encode_string(buffer, key);
+    encode_string(buffer, value);
+  }
+  last_timestamp_ = timestamp;
+  ready_ = true;
+}
+
+void Encoder::encode_common(std::string &buffer, Tag tag, Level level, uint32_t site_id, std::chrono::nanoseconds timestamp, uint32_t thread_id) {
+  buffer.push_back(static_cast<char>(tag));
+  buffer.push_back(static_cast<char>(level));
+  encode_varint(buffer, site_id);
+  encode_signed(buffer, (timestamp - last_timestamp_).count());
+  encode_varint(buffer, thread_id);
+  last_timestamp_ = timestamp;
+}
+
+// note! site ids are the (dense) registry indices, 0 means "none"
+uint32_t Encoder::get_site_id(std::string &buffer, Codec::Description const &description) {
+  auto &site = *description.site;
+  if (site.index < std::size(sites_) && sites_[site.index]) [[likely]] {
+    return site.index;
+  }
+  if (site.index >= std::size(sites_)) {
+    sites_.resize(site.index + 1);
+  }
+  sites_[site.index] = true;
+  buffer.push_back(static_cast<char>(Tag::SITE));
+  encode_varint(buffer, site.index);
+  encode_varint(buffer, site.id);
+  encode_varint(buffer, site.verbosity);
+  buffer.push_back(static_cast<char>(site.prefix));
+  encode_string(buffer, site.file_name);
+  encode_varint(buffer, site.line);
+  encode_string(buffer, site.format);
+  return site.index;
+}
+
+}  // namespace binary
+}  // namespace logging
+}  // namespace roq
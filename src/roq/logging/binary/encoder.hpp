@@ -0,0 +1,53 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "roq/logging/deferred.hpp"
+#include "roq/logging/level.hpp"
+#include "roq/logging/metadata.hpp"
+
+namespace roq {
+namespace logging {
+namespace binary {
+
+// note! not thread-safe (only used by the backend thread)
+struct Encoder final {
+  explicit Encoder(Metadata const &);
+
+  Encoder(Encoder const &) = delete;
+
+  // note! a new file must start with a header (will automatically be written before the first record)
+  void reset();
+
+  // eager (message includes the prefix)
+  void operator()(std::string &buffer, Level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message);
+
+  // deferred
+  void operator()(
+      std::string &buffer, Level, std::chrono::nanoseconds timestamp, uint32_t thread_id, Codec const &, std::span<std::byte const> const &payload);
+
+ protected:
+  void encode_header(std::string &buffer, std::chrono::nanoseconds timestamp);
+  void encode_common(std::string &buffer, Tag, Level, uint32_t site_id, std::chrono::nanoseconds timestamp, uint32_t thread_id);
+
+  uint32_t get_site_id(std::string &buffer, Codec::Description const &);
+
+ private:
+  std::vector<std::pair<std::string, std::string>> const metadata_;
+  bool ready_ = {};
+  std::chrono::nanoseconds last_timestamp_ = {};
+  std::vector<bool> sites_;  // note! indexed by the site registry index
+  std::string text_;
+};
+
+}  // namespace binary
+}  // namespace logging
+}  // namespace roq
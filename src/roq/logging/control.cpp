@@ -0,0 +1,178 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/control.hpp"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/shared.hpp"
+#include "roq/logging/vmodule.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+
+// === HELPERS ===
+
+namespace {
+auto get_directory(std::string_view const &path) -> std::string {
+  auto slash = path.rfind('/');
+  if (slash == path.npos) {
+    return "."s;
+  }
+  if (slash == 0) {
+    return "/"s;
+  }
+  return std::string{path.substr(0, slash)};
+}
+
+auto get_name(std::string_view const &path) -> std::string {
+  auto slash = path.rfind('/');
+  return std::string{slash == path.npos ? path : path.substr(slash + 1)};
+}
+
+auto create_inotify_fd() {
+  auto result = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (result < 0) {
+    throw RuntimeError{R"(Unable to create inotify: error="{}")"sv, std::strerror(errno)};
+  }
+  return result;
+}
+
+auto create_event_fd() {
+  auto result = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (result < 0) {
+    throw RuntimeError{R"(Unable to create eventfd: error="{}")"sv, std::strerror(errno)};
+  }
+  return result;
+}
+
+auto trim(std::string_view const &value) {
+  auto first = value.find_first_not_of(" \t\r"sv);
+  if (first == value.npos) {
+    return std::string_view{};
+  }
+  auto last = value.find_last_not_of(" \t\r"sv);
+  return value.substr(first, last - first + 1);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Control::Control(std::string_view const &path)
+    : path_{path}, directory_{get_directory(path)}, name_{get_name(path)}, inotify_fd_{create_inotify_fd()}, event_fd_{create_event_fd()} {
+  // note! watching the directory allows the file to be replaced (e.g. rename) or not yet exist
+  if (::inotify_add_watch(inotify_fd_, directory_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    auto error = errno;
+    ::close(inotify_fd_);
+    ::close(event_fd_);
+    throw RuntimeError{R"(Unable to watch directory: path="{}", error="{}")"sv, directory_, std::strerror(error)};
+  }
+  load();
+  thread_ = std::thread{[this]() { run(); }};
+}
+
+Control::~Control() {
+  uint64_t value = 1;
+  [[maybe_unused]] auto result = ::write(event_fd_, &value, sizeof(value));
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  ::close(inotify_fd_);
+  ::close(event_fd_);
+}
+
+void Control::run() {
+  std::array<pollfd, 2> fds{{
+      {.fd = inotify_fd_, .events = POLLIN, .revents = 0},
+      {.fd = event_fd_, .events = POLLIN, .revents = 0},
+  }};
+  alignas(inotify_event) std::array<char, 4096> buffer;
+  while (true) {
+    auto result = ::poll(std::data(fds), std::size(fds), -1);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      log::warn(R"(logging: poll failed (error="{}"))"sv, std::strerror(errno));
+      return;
+    }
+    if (fds[1].revents != 0) {
+      return;
+    }
+    auto reload = false;
+    while (true) {
+      auto length = ::read(inotify_fd_, std::data(buffer), std::size(buffer));
+      if (length <= 0) {
+        break;
+      }
+      for (ssize_t offset = 0; offset < length;) {
+        auto &event = *reinterpret_cast<inotify_event const *>(&buffer[offset]);
+        if (event.len > 0 && name_ == event.name) {
+          reload = true;
+        }
+        offset += sizeof(inotify_event) + event.len;
+      }
+    }
+    if (reload) {
+      load();
+    }
+  }
+}
+
+void Control::load() {
+  std::ifstream file{path_};
+  if (!file.is_open()) {
+    return;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::string_view tmp{line};
+    auto comment = tmp.find('#');
+    if (comment != tmp.npos) {
+      tmp = tmp.substr(0, comment);
+    }
+    tmp = trim(tmp);
+    if (std::empty(tmp)) {
+      continue;
+    }
+    auto equal = tmp.find('=');
+    auto key = trim(tmp.substr(0, equal));
+    auto value = equal == tmp.npos ? std::string_view{} : trim(tmp.substr(equal + 1));
+    try {
+      if (key == "verbosity"sv) {
+        size_t result = {};
+        auto [ptr, ec] = std::from_chars(std::data(value), std::data(value) + std::size(value), result);
+        if (ec != std::errc{} || ptr != (std::data(value) + std::size(value))) {
+          throw RuntimeError{R"(Invalid verbosity: "{}")"sv, value};
+        }
+        if (verbosity.exchange(result, std::memory_order_relaxed) != result) {
+          log::info("logging: verbosity={}"sv, result);
+        }
+      } else if (key == "vmodule"sv) {
+        set_vmodule(value);
+        log::info(R"(logging: vmodule="{}")"sv, value);
+      } else {
+        throw RuntimeError{R"(Unknown key: "{}")"sv, key};
+      }
+    } catch (RuntimeError &e) {
+      log::warn(R"(logging: control file "{}": {})"sv, path_, e.what());
+    }
+  }
+}
+
+}  // namespace logging
+}  // namespace roq
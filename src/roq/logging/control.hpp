@@ -0,0 +1,38 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace roq {
+namespace logging {
+
+// control file
+// - watched (inotify) by a background thread and (re)loaded whenever it has been written or replaced
+// - one key=value per line, '#' starts a comment
+// - supported keys: verbosity, vmodule (absent keys are left unchanged)
+
+struct Control final {
+  explicit Control(std::string_view const &path);
+
+  Control(Control const &) = delete;
+
+  ~Control();
+
+ protected:
+  void run();
+  void load();
+
+ private:
+  std::string const path_;
+  std::string const directory_;
+  std::string const name_;
+  int const inotify_fd_;
+  int const event_fd_;
+  std::thread thread_;
+};
+
+}  // namespace logging
+}  // namespace roq
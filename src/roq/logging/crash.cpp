@@ -0,0 +1,342 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/crash.hpp"
+
+#include <absl/debugging/symbolize.h>
+
+#include <execinfo.h>
+#include <fcntl.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+#include "roq/logging/handler.hpp"
+#include "roq/logging/shared.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+
+// === CONSTANTS ===
+
+namespace {
+size_t const LENGTH_ADDR = 32;
+size_t const LENGTH_NAME = 256;
+size_t const LENGTH_BUFFER = 4096;
+size_t const LENGTH_PATH = 4096;
+size_t const LENGTH_STACK = 65536;
+
+auto const SIGNALS = std::array{SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV};
+
+auto const WAIT_SLEEP = timespec{.tv_sec = 1, .tv_nsec = 0};
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! preallocated (the signal handler must not allocate)
+std::array<char, LENGTH_PATH> CRASH_PATH = {};
+std::array<char, LENGTH_BUFFER> BUFFER = {};
+std::array<char, LENGTH_NAME> NAME = {};
+std::array<void *, LENGTH_ADDR> ADDR = {};
+alignas(16) std::array<std::byte, LENGTH_STACK> STACK = {};
+
+std::atomic<pid_t> CRASHING_THREAD = {};  // note! first thread to enter the signal handler
+
+static_assert(std::atomic<pid_t>::is_always_lock_free);
+
+void write_all(int fd, char const *data, size_t length) {
+  while (length > 0) {
+    auto result = ::write(fd, data, length);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data += result;
+    length -= static_cast<size_t>(result);
+  }
+}
+
+// note! async-signal-safe formatting into a preallocated buffer, flushed to all outputs whenever full
+struct Writer final {
+  Writer(int fd_1, int fd_2) : fds_{fd_1, fd_2} {}
+
+  Writer(Writer const &) = delete;
+
+  ~Writer() { flush(); }
+
+  Writer &operator<<(std::string_view const &text) {
+    for (auto c : text) {
+      put(c);
+    }
+    return *this;
+  }
+
+  Writer &operator<<(char const *text) { return (*this) << std::string_view{text, std::strlen(text)}; }
+
+  Writer &operator<<(char c) {
+    put(c);
+    return *this;
+  }
+
+  Writer &dec(uint64_t value) {
+    std::array<char, 20> tmp;
+    size_t length = 0;
+    do {
+      tmp[length++] = static_cast<char>('0' + (value % 10));
+      value /= 10;
+    } while (value != 0);
+    while (length > 0) {
+      put(tmp[--length]);
+    }
+    return *this;
+  }
+
+  Writer &dec(int64_t value) {
+    if (value < 0) {
+      put('-');
+      return dec(static_cast<uint64_t>(0) - static_cast<uint64_t>(value));
+    }
+    return dec(static_cast<uint64_t>(value));
+  }
+
+  Writer &hex(uint64_t value, size_t width = 16) {
+    static constexpr char const DIGITS[] = "0123456789abcdef";
+    (*this) << "0x"sv;
+    for (size_t i = width; i > 0; --i) {
+      put(DIGITS[(value >> ((i - 1) * 4)) & 0xf]);
+    }
+    return *this;
+  }
+
+  Writer &pad(uint64_t value, size_t width) {
+    uint64_t limit = 1;
+    for (size_t i = 1; i < width; ++i) {
+      limit *= 10;
+      if (value < limit) {
+        put(' ');
+      }
+    }
+    return dec(value);
+  }
+
+  void flush() {
+    for (auto fd : fds_) {
+      if (fd >= 0) {
+        write_all(fd, std::data(BUFFER), length_);
+      }
+    }
+    length_ = 0;
+  }
+
+ protected:
+  void put(char c) {
+    if (length_ == std::size(BUFFER)) [[unlikely]] {
+      flush();
+    }
+    BUFFER[length_++] = c;
+  }
+
+ private:
+  std::array<int, 2> const fds_;
+  size_t length_ = {};
+};
+
+std::string_view get_signal_name(int sig) {
+  switch (sig) {
+    case SIGABRT:
+      return "SIGABRT"sv;
+    case SIGBUS:
+      return "SIGBUS"sv;
+    case SIGFPE:
+      return "SIGFPE"sv;
+    case SIGILL:
+      return "SIGILL"sv;
+    case SIGSEGV:
+      return "SIGSEGV"sv;
+  }
+  return "?"sv;
+}
+
+void write_registers([[maybe_unused]] Writer &writer, [[maybe_unused]] void *context) {
+  if (context == nullptr) {
+    return;
+  }
+#if defined(__linux__) && defined(__x86_64__)
+  auto &gregs = static_cast<ucontext_t *>(context)->uc_mcontext.gregs;
+  struct Register final {
+    std::string_view name;
+    int index;
+  };
+  static constexpr Register const REGISTERS[] = {
+      {"rip"sv, REG_RIP}, {"rsp"sv, REG_RSP}, {"rbp"sv, REG_RBP}, {"efl"sv, REG_EFL}, {"rax"sv, REG_RAX}, {"rbx"sv, REG_RBX},
+      {"rcx"sv, REG_RCX}, {"rdx"sv, REG_RDX}, {"rsi"sv, REG_RSI}, {"rdi"sv, REG_RDI}, {"r8"sv, REG_R8},   {"r9"sv, REG_R9},
+      {"r10"sv, REG_R10}, {"r11"sv, REG_R11}, {"r12"sv, REG_R12}, {"r13"sv, REG_R13}, {"r14"sv, REG_R14}, {"r15"sv, REG_R15},
+  };
+  writer << "registers:\n"sv;
+  size_t count = 0;
+  for (auto &item : REGISTERS) {
+    writer << (count % 4 == 0 ? "  "sv : " "sv) << item.name << '=';
+    writer.hex(static_cast<uint64_t>(gregs[item.index]));
+    if (++count % 4 == 0) {
+      writer << '\n';
+    }
+  }
+  if (count % 4 != 0) {
+    writer << '\n';
+  }
+#elif defined(__linux__) && defined(__aarch64__)
+  auto &mcontext = static_cast<ucontext_t *>(context)->uc_mcontext;
+  writer << "registers:\n  pc="sv;
+  writer.hex(mcontext.pc) << " sp="sv;
+  writer.hex(mcontext.sp) << " pstate="sv;
+  writer.hex(mcontext.pstate) << '\n';
+  for (size_t i = 0; i < 31; ++i) {
+    writer << (i % 4 == 0 ? "  x"sv : " x"sv);
+    writer.dec(static_cast<uint64_t>(i)) << '=';
+    writer.hex(mcontext.regs[i]);
+    if (i % 4 == 3) {
+      writer << '\n';
+    }
+  }
+  writer << '\n';
+#endif
+}
+
+// note! backtrace is warmed up during installation (the first call may allocate when loading libgcc)
+// note! absl::Symbolize is async-signal-safe
+void write_backtrace(Writer &writer) {
+  auto depth = ::backtrace(std::data(ADDR), static_cast<int>(std::size(ADDR)));
+  if (depth <= 0) {
+    writer << "can't get stacktrace\n"sv;
+    return;
+  }
+  writer << "backtrace:\n"sv;
+  for (int i = 0; i < depth; ++i) {
+    char const *symbol = "(unknown)";
+    // note! this signature does not include the arguments
+    // --> so we still prefer libunwind
+    if (absl::Symbolize(ADDR[i], std::data(NAME), std::size(NAME))) {
+      symbol = std::data(NAME);
+    }
+    writer << '[';
+    writer.pad(static_cast<uint64_t>(i), 2) << "] "sv;
+    writer.hex(reinterpret_cast<uintptr_t>(ADDR[i])) << ' ' << symbol << '\n';
+  }
+}
+
+void write_report(int fd, int sig, siginfo_t *info, void *context) {
+  Writer writer{STDERR_FILENO, fd};
+  struct timespec now = {};
+  ::clock_gettime(CLOCK_REALTIME, &now);
+  writer << "*** TERMINATION HANDLER ***\n"sv;
+  writer << "time="sv;
+  writer.dec(static_cast<int64_t>(now.tv_sec)) << '.';
+  auto nanos = static_cast<uint64_t>(now.tv_nsec);
+  for (uint64_t divisor = 100000000; divisor > 0; divisor /= 10) {
+    writer << static_cast<char>('0' + ((nanos / divisor) % 10));
+  }
+  writer << ", pid="sv;
+  writer.dec(static_cast<int64_t>(::getpid())) << ", thread_id="sv;
+  writer.dec(static_cast<int64_t>(::gettid())) << '\n';
+  writer << "signal="sv;
+  writer.dec(static_cast<int64_t>(sig)) << " ("sv << get_signal_name(sig) << ')';
+  if (info != nullptr) {
+    writer << ", code="sv;
+    writer.dec(static_cast<int64_t>((*info).si_code)) << ", address="sv;
+    writer.hex(reinterpret_cast<uintptr_t>((*info).si_addr));
+  }
+  writer << '\n';
+  write_registers(writer, context);
+  write_backtrace(writer);
+}
+
+void invoke_default_signal_handler(int signal) {
+  struct sigaction action = {};
+  sigemptyset(&action.sa_mask);
+  action.sa_handler = SIG_DFL;
+  sigaction(signal, &action, nullptr);
+  kill(getpid(), signal);
+}
+
+// note! the report is written first (it is async-signal-safe) and draining is bounded by a timeout
+void termination_handler(int sig, siginfo_t *info, void *context) {
+  auto thread_id = ::gettid();
+  pid_t expected = 0;
+  if (!CRASHING_THREAD.compare_exchange_strong(expected, thread_id)) {
+    if (expected == thread_id) {
+      // note! crashed while reporting
+      invoke_default_signal_handler(sig);
+      return;
+    }
+    // note! another thread is reporting and will terminate the process
+    while (true) {
+      ::nanosleep(&WAIT_SLEEP, nullptr);
+    }
+  }
+  auto fd = -1;
+  if (CRASH_PATH[0] != '\0') {
+    fd = ::open(std::data(CRASH_PATH), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  }
+  write_report(fd, sig, info, context);
+  if (fd >= 0) {
+    ::fsync(fd);
+    ::close(fd);
+  }
+  Handler::drain_instance(drain_timeout, true);
+  invoke_default_signal_handler(sig);
+}
+
+void install_alternate_signal_stack() {
+  stack_t stack = {};
+  stack.ss_sp = std::data(STACK);
+  stack.ss_size = std::size(STACK);
+  stack.ss_flags = 0;
+  sigaltstack(&stack, nullptr);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+std::string get_crash_path(std::string_view const &log_path) {
+  if (std::empty(log_path)) {
+    return {};
+  }
+  auto separator = log_path.find_last_of('/');
+  auto dot = log_path.find_last_of('.');
+  // note! no extension, hidden file or dot in directory name
+  if (dot == log_path.npos || dot == 0 || (separator != log_path.npos && dot <= (separator + 1))) {
+    return std::string{log_path}.append(".crash"sv);
+  }
+  return std::string{log_path.substr(0, dot)}.append(".crash"sv);
+}
+
+void install_crash_handler(std::string_view const &log_path) {
+  auto path = get_crash_path(log_path);
+  if (std::size(path) < std::size(CRASH_PATH)) {
+    std::memcpy(std::data(CRASH_PATH), std::data(path), std::size(path));
+    CRASH_PATH[std::size(path)] = '\0';
+  }
+  ::backtrace(std::data(ADDR), static_cast<int>(std::size(ADDR)));
+  install_alternate_signal_stack();
+  struct sigaction action = {};
+  sigemptyset(&action.sa_mask);
+  action.sa_sigaction = termination_handler;
+  action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+  for (auto sig : SIGNALS) {
+    sigaction(sig, &action, nullptr);
+  }
+}
+
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,28 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace roq {
+namespace logging {
+
+// crash reporter (failure signals: SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV)
+// - async-signal-safe: preallocated buffers and raw write(2), no allocation and no locks
+// - the report is written to stderr and appended to a crash file next to the log file (if any)
+// - the report includes signal, fault address, thread id, registers and backtrace (addresses and symbols)
+// - the asynchronous queue is drained before the default signal handler terminates the process
+// - the installing thread gets an alternate signal stack (so we can report stack overflow)
+// note! only the first crashing thread reports, other threads will wait for the process to terminate
+
+// note! "/path/to/file.log" becomes "/path/to/file.crash" (empty if no log path)
+ROQ_PUBLIC std::string get_crash_path(std::string_view const &log_path);
+
+// note! should only be called once (during initialization)
+ROQ_PUBLIC void install_crash_handler(std::string_view const &log_path);
+
+}  // namespace logging
+}  // namespace roq
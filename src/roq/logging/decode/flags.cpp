@@ -0,0 +1,28 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/decode/flags.hpp"
+
+#include <absl/flags/flag.h>
+
+#include <string>
+
+using namespace std::literals;
+
+ABSL_FLAG(  //
+    bool,
+    metadata,
+    false,
+    "output the metadata (prefixed by #)"s);
+
+namespace roq {
+namespace logging {
+namespace decode {
+
+bool Flags::metadata() {
+  static bool const result = absl::GetFlag(FLAGS_metadata);
+  return result;
+}
+
+}  // namespace decode
+}  // namespace logging
+}  // namespace roq
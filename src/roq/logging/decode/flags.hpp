@@ -0,0 +1,15 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+namespace roq {
+namespace logging {
+namespace decode {
+
+struct Flags final {
+  static bool metadata();
+};
+
+}  // namespace decode
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,113 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <fmt/format.h>
+
+#include <unistd.h>
+
+#include <fcntl.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "roq/flags/args.hpp"
+
+#include "roq/logging/binary/decoder.hpp"
+
+#include "roq/logging/decode/flags.hpp"
+
+using namespace std::literals;
+
+using namespace roq::logging;
+
+// converts binary log files back to glog style text
+// usage: roq-logging-decode [--metadata] [FILE...] (stdin if no files)
+
+// === CONSTANTS ===
+
+namespace {
+auto const DESCRIPTION = "roq-logging-decode"sv;
+auto const BUFFER_SIZE = 1048576uz;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+struct Handler final : public binary::Decoder::Handler {
+  explicit Handler(bool metadata) : metadata_{metadata} {}
+
+ protected:
+  void operator()(std::vector<std::pair<std::string, std::string>> const &metadata) override {
+    if (!metadata_) {
+      return;
+    }
+    for (auto &[key, value] : metadata) {
+      fmt::println("# {}: {}"sv, key, value);
+    }
+  }
+
+  void operator()(std::string_view const &line) override { fmt::println("{}"sv, line); }
+
+ private:
+  bool const metadata_;
+};
+
+bool process(int fd, std::string_view const &name, Handler &handler) {
+  binary::Decoder decoder{handler};
+  std::string buffer;
+  std::vector<char> chunk(BUFFER_SIZE);
+  while (true) {
+    auto result = ::read(fd, std::data(chunk), std::size(chunk));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fmt::println(stderr, R"(Unable to read: name="{}", error="{}")"sv, name, std::strerror(errno));
+      return false;
+    }
+    if (result == 0) {
+      break;
+    }
+    buffer.append(std::data(chunk), result);
+    auto length = decoder(buffer);
+    buffer.erase(0, length);
+  }
+  if (!std::empty(buffer)) {
+    fmt::println(stderr, R"(Truncated: name="{}", bytes={})"sv, name, std::size(buffer));
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+int main(int argc, char **argv) {
+  auto result = true;
+  try {
+    roq::flags::Args args{argc, argv, DESCRIPTION, ROQ_VERSION};
+    auto paths = args.get();
+    Handler handler{decode::Flags::metadata()};
+    if (std::empty(paths)) {
+      result = process(STDIN_FILENO, "<stdin>"sv, handler);
+    }
+    for (auto &path : paths) {
+      std::string tmp{path};
+      auto fd = ::open(tmp.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        fmt::println(stderr, R"(Unable to open: path="{}", error="{}")"sv, path, std::strerror(errno));
+        result = false;
+        continue;
+      }
+      result = process(fd, path, handler) && result;
+      ::close(fd);
+    }
+  } catch (std::exception &e) {
+    fmt::println(stderr, R"(Exception: what="{}")"sv, e.what());
+    return EXIT_FAILURE;
+  }
+  return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,6 +4,10 @@
 
 #include "roq/exceptions.hpp"
 
+#include "roq/logging/ring/logger.hpp"
+
+#include "roq/logging/shm/logger.hpp"
+
 #include "roq/logging/spdlog/logger.hpp"
 
 #include "roq/logging/standard/logger.hpp"
@@ -13,15 +17,63 @@ using namespace std::literals;
 namespace roq {
 namespace logging {
 
+// === HELPERS ===
+
+namespace {
+bool is_compression_none(auto &compression) {
+  return std::empty(compression) || compression == "none"sv;
+}
+
+bool is_wait_strategy_sleep(auto &wait_strategy) {
+  return std::empty(wait_strategy) || wait_strategy == "sleep"sv;
+}
+}  // namespace
+
 // === IMPLEMENTATION ===
 
 std::unique_ptr<Handler> Factory::create(std::string_view const &type, Settings const &settings) {
+  return create(type, settings, {});
+}
+
+std::unique_ptr<Handler> Factory::create(std::string_view const &type, Settings const &settings, Metadata const &metadata) {
+  if (std::empty(settings.log.format) || settings.log.format == "text"sv) {
+  } else if (settings.log.format == "binary"sv) {
+    if (type != "ring"sv) {
+      throw RuntimeError{R"(Binary format is not supported by logging type: "{}")"sv, type};
+    }
+    // note! eager messages would be encoded as text (including the prefix)
+    if (!settings.log.deferred) {
+      throw RuntimeError{"Binary format requires deferred formatting"sv};
+    }
+  } else {
+    throw RuntimeError{R"(Unknown log format: "{}")"sv, settings.log.format};
+  }
+  if (settings.log.mmap && type != "ring"sv) {
+    throw RuntimeError{R"(Memory-mapped file is not supported by logging type: "{}")"sv, type};
+  }
+  if (settings.log.deferred && type != "ring"sv) {
+    throw RuntimeError{R"(Deferred formatting is not supported by logging type: "{}")"sv, type};
+  }
+  if (!is_compression_none(settings.log.compression) || !is_compression_none(settings.log.compression_rotated)) {
+    if (type != "ring"sv) {
+      throw RuntimeError{R"(Compression is not supported by logging type: "{}")"sv, type};
+    }
+  }
+  if (!is_wait_strategy_sleep(settings.log.wait_strategy) && type != "ring"sv) {
+    throw RuntimeError{R"(Wait strategy is not supported by logging type: "{}")"sv, type};
+  }
   if (std::empty(type) || type == "std"sv || type == "standard"sv) {
     return std::make_unique<standard::Logger>(settings);
   }
+  if (type == "ring"sv) {
+    return std::make_unique<ring::Logger>(settings, metadata);
+  }
   if (type == "spdlog"sv) {
     return std::make_unique<spdlog::Logger>(settings);
   }
+  if (type == "shm"sv) {
+    return std::make_unique<shm::Logger>(settings);
+  }
   throw RuntimeError{R"(Unknown logging type: "{}")"sv, type};
 }
 
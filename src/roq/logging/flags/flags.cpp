@@ -61,7 +61,7 @@ ABSL_FLAG(  //
     "log file (path)"s);
 
 ABSL_FLAG(  //
-    uint32_t,
+    uint64_t,
     log_max_size,
     1073741824,  // 1GB
     "max size of log file before rotating (only if path is non-empty)"s);
@@ -90,6 +90,150 @@ ABSL_FLAG(  //
     0,
     "verbosity (0-5), ROQ_v environment variable has priority"s);
 
+ABSL_FLAG(  //
+    std::string,
+    log_vmodule,
+    {},
+    "per-module verbosity (comma separated list of pattern=N), ROQ_vmodule environment variable has priority"s);
+
+ABSL_FLAG(  //
+    bool,
+    log_verbosity_signals,
+    false,
+    "change verbosity at runtime? (SIGUSR1 increments, SIGUSR2 decrements)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_control_file,
+    {},
+    "control file (path), watched for runtime changes (key=value lines, supported keys: verbosity, vmodule)"s);
+
+ABSL_FLAG(  //
+    bool,
+    log_deferred,
+    false,
+    "defer formatting to the backend thread? (only if supported by the logging handler)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_format,
+    "text"s,
+    "log file format (one of: text, binary), binary requires a log path and deferred formatting"s);
+
+ABSL_FLAG(  //
+    bool,
+    log_mmap,
+    false,
+    "write log file using a memory-mapped and preallocated file? (only if path is non-empty)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_compression,
+    "none"s,
+    "streaming compression of the log file (one of: none, zstd), requires a log path"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_compression_rotated,
+    "none"s,
+    "background compression of rotated log files (one of: none, zstd)"s);
+
+ABSL_FLAG(  //
+    int32_t,
+    log_compression_level,
+    3,
+    "compression level"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_thread_name,
+    {},
+    "backend thread name (max 15 characters)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_thread_affinity,
+    {},
+    "backend thread cpu affinity (cpu list, e.g. 1,3-4)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_thread_policy,
+    {},
+    "backend thread scheduling policy (one of: other, batch, idle, fifo, rr)"s);
+
+ABSL_FLAG(  //
+    int32_t,
+    log_thread_priority,
+    0,
+    "backend thread priority (nice value for other, batch and idle, real-time priority for fifo and rr)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_wait_strategy,
+    "sleep"s,
+    "backend thread wait strategy when idle (one of: sleep, spin, yield, block), only if supported by the logging handler"s);
+
+ABSL_FLAG(  //
+    uint32_t,
+    log_wait_spin_count,
+    0,
+    "backend thread busy-spin iterations (when idle) before yielding"s);
+
+ABSL_FLAG(  //
+    uint32_t,
+    log_wait_yield_count,
+    0,
+    "backend thread yield iterations (when idle) before sleeping or blocking"s);
+
+ABSL_FLAG(  //
+    uint64_t,
+    log_queue_capacity,
+    0,
+    "asynchronous queue capacity (0 means default), spdlog: messages, ring: bytes (per producer thread)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_overflow_policy,
+    "block"s,
+    "asynchronous queue overflow policy (one of: block, drop_newest, drop_oldest, drop_below_level), drop_below_level always blocks for WARNING and above"s);
+
+ABSL_FLAG(  //
+    bool,
+    log_metrics,
+    false,
+    "collect logging metrics (messages, bytes and latency per call)"s);
+
+ABSL_FLAG(  //
+    TimePeriod,
+    log_metrics_freq,
+    {},
+    "dump logging metrics every (0 means never, only asynchronous logging)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_structured_format,
+    "logfmt"s,
+    "structured logging format (one of: logfmt, json)"s);
+
+ABSL_FLAG(  //
+    TimePeriod,
+    log_drain_timeout,
+    {1s},
+    "max time spent draining the queue when terminating (fatal or failure signal)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_sinks,
+    ""s,
+    "additional sinks, comma separated list of type[@level][=path] (type is one of: stdout, stderr, file)"s);
+
+ABSL_FLAG(  //
+    std::string,
+    log_shm_name,
+    ""s,
+    "shared memory segment name (only used by the shm logging type, see roq-logging-tail), removed on exit unless records have not been consumed"s);
+
 namespace roq {
 namespace logging {
 namespace flags {
@@ -109,8 +253,8 @@ std::string_view Flags::log_path() {
   return result;
 }
 
-uint32_t Flags::log_max_size() {
-  static uint32_t const result = absl::GetFlag(FLAGS_log_max_size);
+uint64_t Flags::log_max_size() {
+  static uint64_t const result = absl::GetFlag(FLAGS_log_max_size);
   return result;
 }
 
@@ -134,6 +278,126 @@ uint32_t Flags::log_verbosity() {
   return result;
 }
 
+std::string_view Flags::log_vmodule() {
+  static std::string const result = absl::GetFlag(FLAGS_log_vmodule);
+  return result;
+}
+
+bool Flags::log_verbosity_signals() {
+  static bool const result = absl::GetFlag(FLAGS_log_verbosity_signals);
+  return result;
+}
+
+std::string_view Flags::log_control_file() {
+  static std::string const result = absl::GetFlag(FLAGS_log_control_file);
+  return result;
+}
+
+bool Flags::log_deferred() {
+  static bool const result = absl::GetFlag(FLAGS_log_deferred);
+  return result;
+}
+
+std::string_view Flags::log_format() {
+  static std::string const result = absl::GetFlag(FLAGS_log_format);
+  return result;
+}
+
+bool Flags::log_mmap() {
+  static bool const result = absl::GetFlag(FLAGS_log_mmap);
+  return result;
+}
+
+std::string_view Flags::log_compression() {
+  static std::string const result = absl::GetFlag(FLAGS_log_compression);
+  return result;
+}
+
+std::string_view Flags::log_compression_rotated() {
+  static std::string const result = absl::GetFlag(FLAGS_log_compression_rotated);
+  return result;
+}
+
+int32_t Flags::log_compression_level() {
+  static int32_t const result = absl::GetFlag(FLAGS_log_compression_level);
+  return result;
+}
+
+std::string_view Flags::log_thread_name() {
+  static std::string const result = absl::GetFlag(FLAGS_log_thread_name);
+  return result;
+}
+
+std::string_view Flags::log_thread_affinity() {
+  static std::string const result = absl::GetFlag(FLAGS_log_thread_affinity);
+  return result;
+}
+
+std::string_view Flags::log_thread_policy() {
+  static std::string const result = absl::GetFlag(FLAGS_log_thread_policy);
+  return result;
+}
+
+int32_t Flags::log_thread_priority() {
+  static int32_t const result = absl::GetFlag(FLAGS_log_thread_priority);
+  return result;
+}
+
+std::string_view Flags::log_wait_strategy() {
+  static std::string const result = absl::GetFlag(FLAGS_log_wait_strategy);
+  return result;
+}
+
+uint32_t Flags::log_wait_spin_count() {
+  static uint32_t const result = absl::GetFlag(FLAGS_log_wait_spin_count);
+  return result;
+}
+
+uint32_t Flags::log_wait_yield_count() {
+  static uint32_t const result = absl::GetFlag(FLAGS_log_wait_yield_count);
+  return result;
+}
+
+uint64_t Flags::log_queue_capacity() {
+  static uint64_t const result = absl::GetFlag(FLAGS_log_queue_capacity);
+  return result;
+}
+
+std::string_view Flags::log_overflow_policy() {
+  static std::string const result = absl::GetFlag(FLAGS_log_overflow_policy);
+  return result;
+}
+
+bool Flags::log_metrics() {
+  static bool const result = absl::GetFlag(FLAGS_log_metrics);
+  return result;
+}
+
+std::chrono::nanoseconds Flags::log_metrics_freq() {
+  static std::chrono::nanoseconds const result{absl::ToChronoNanoseconds(absl::GetFlag(FLAGS_log_metrics_freq))};
+  return result;
+}
+
+std::string_view Flags::log_structured_format() {
+  static std::string const result = absl::GetFlag(FLAGS_log_structured_format);
+  return result;
+}
+
+std::chrono::nanoseconds Flags::log_drain_timeout() {
+  static std::chrono::nanoseconds const result{absl::ToChronoNanoseconds(absl::GetFlag(FLAGS_log_drain_timeout))};
+  return result;
+}
+
+std::string_view Flags::log_sinks() {
+  static std::string const result = absl::GetFlag(FLAGS_log_sinks);
+  return result;
+}
+
+std::string_view Flags::log_shm_name() {
+  static std::string const result = absl::GetFlag(FLAGS_log_shm_name);
+  return result;
+}
+
 }  // namespace flags
 }  // namespace logging
 }  // namespace roq
@@ -14,11 +14,35 @@ struct Flags final {
   static std::string_view log_pattern();
   static std::chrono::nanoseconds log_flush_freq();
   static std::string_view log_path();
-  static uint32_t log_max_size();
+  static uint64_t log_max_size();
   static uint32_t log_max_files();
   static bool log_rotate_on_open();
   static std::string_view color();
   static uint32_t log_verbosity();
+  static std::string_view log_vmodule();
+  static bool log_verbosity_signals();
+  static std::string_view log_control_file();
+  static bool log_deferred();
+  static std::string_view log_format();
+  static bool log_mmap();
+  static std::string_view log_compression();
+  static std::string_view log_compression_rotated();
+  static int32_t log_compression_level();
+  static std::string_view log_thread_name();
+  static std::string_view log_thread_affinity();
+  static std::string_view log_thread_policy();
+  static int32_t log_thread_priority();
+  static std::string_view log_wait_strategy();
+  static uint32_t log_wait_spin_count();
+  static uint32_t log_wait_yield_count();
+  static uint64_t log_queue_capacity();
+  static std::string_view log_overflow_policy();
+  static bool log_metrics();
+  static std::chrono::nanoseconds log_metrics_freq();
+  static std::string_view log_structured_format();
+  static std::chrono::nanoseconds log_drain_timeout();
+  static std::string_view log_sinks();
+  static std::string_view log_shm_name();
 };
 
 }  // namespace flags
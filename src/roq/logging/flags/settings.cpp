@@ -22,6 +22,30 @@ auto create_settings() -> roq::logging::Settings {
           .rotate_on_open = Flags::log_rotate_on_open(),
           .color = Flags::color(),
           .verbosity = Flags::log_verbosity(),
+          .vmodule = Flags::log_vmodule(),
+          .verbosity_signals = Flags::log_verbosity_signals(),
+          .control_file = Flags::log_control_file(),
+          .deferred = Flags::log_deferred(),
+          .format = Flags::log_format(),
+          .mmap = Flags::log_mmap(),
+          .compression = Flags::log_compression(),
+          .compression_rotated = Flags::log_compression_rotated(),
+          .compression_level = Flags::log_compression_level(),
+          .thread_name = Flags::log_thread_name(),
+          .thread_affinity = Flags::log_thread_affinity(),
+          .thread_policy = Flags::log_thread_policy(),
+          .thread_priority = Flags::log_thread_priority(),
+          .wait_strategy = Flags::log_wait_strategy(),
+          .wait_spin_count = Flags::log_wait_spin_count(),
+          .wait_yield_count = Flags::log_wait_yield_count(),
+          .queue_capacity = Flags::log_queue_capacity(),
+          .overflow_policy = Flags::log_overflow_policy(),
+          .metrics = Flags::log_metrics(),
+          .metrics_freq = Flags::log_metrics_freq(),
+          .structured_format = Flags::log_structured_format(),
+          .drain_timeout = Flags::log_drain_timeout(),
+          .sinks = Flags::log_sinks(),
+          .shm_name = Flags::log_shm_name(),
       },
   };
 }
@@ -9,6 +9,7 @@
 #include "roq/exceptions.hpp"
 
 #include "roq/logging/shared.hpp"
+#include "roq/logging/stats.hpp"
 
 #include "roq/logging/standard/logger.hpp"
 
@@ -51,7 +52,10 @@ Default DEFAULT_LOGGER;
 
 // === IMPLEMENTATION ===
 
-Handler::Handler() {
+Handler::Handler() : Handler{false} {
+}
+
+Handler::Handler(bool two_phase) : two_phase_{two_phase} {
   if (COUNT >= 2) {
     throw RuntimeError{"Logger is singleton"sv};
   }
@@ -77,5 +81,34 @@ Handler::~Handler() {
   --COUNT;
 }
 
+std::span<char> Handler::reserve(Level) {
+  return {};
+}
+
+void Handler::commit(Level, size_t) {
+}
+
+std::span<std::byte> Handler::reserve_deferred(Level, Codec const &, size_t) {
+  return {};
+}
+
+bool Handler::drain(std::chrono::nanoseconds, bool) {
+  return true;
+}
+
+bool Handler::drain_instance(std::chrono::nanoseconds timeout, bool signal) {
+  auto instance = INSTANCE;
+  if (instance == nullptr) {
+    return true;
+  }
+  return (*instance).drain(timeout, signal);
+}
+
+Stats Handler::get_stats() const {
+  Stats result;
+  detail::Metrics::get(result);
+  return result;
+}
+
 }  // namespace logging
 }  // namespace roq
@@ -2,12 +2,10 @@
 
 #include "roq/logging/logger.hpp"
 
-#include <absl/debugging/stacktrace.h>
 #include <absl/debugging/symbolize.h>
 
 #include <fmt/format.h>
 
-#include <execinfo.h>
 #include <unistd.h>
 
 #include <chrono>
@@ -15,7 +13,13 @@
 #include <cstdlib>
 #include <memory>
 
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/control.hpp"
+#include "roq/logging/crash.hpp"
 #include "roq/logging/shared.hpp"
+#include "roq/logging/structured.hpp"
+#include "roq/logging/vmodule.hpp"
 
 using namespace std::literals;
 using namespace std::chrono_literals;
@@ -23,56 +27,27 @@ using namespace std::chrono_literals;
 namespace roq {
 namespace logging {
 
-// === CONSTANTS ===
-
-namespace {
-size_t const LENGTH_ADDR = 32;
-size_t const LENGTH_NAME = 256;
-}  // namespace
-
 // === HELPERS ===
 
 namespace {
-void invoke_default_signal_handler(int signal) {
-  struct sigaction action = {};
-  sigemptyset(&action.sa_mask);
-  action.sa_handler = SIG_DFL;
-  sigaction(signal, &action, nullptr);
-  kill(getpid(), signal);
-}
-
-void termination_handler(int sig, [[maybe_unused]] siginfo_t *info, void *) {
-  fmt::println(stderr, "*** TERMINATION HANDLER ***"sv);
-#if defined(__linux__)
-  psiginfo(info, nullptr);
-#endif
-  std::array<void *, LENGTH_ADDR> addr;
-  int depth = ::backtrace(std::data(addr), std::size(addr));
-  if (depth != 0) {
-    std::array<char, LENGTH_NAME> name;
-    for (int i = 0; i < depth; ++i) {
-      char const *symbol = "(unknown)";
-      // note! this signature does not include the arguments
-      // --> so we still prefer libunwind
-      auto result = absl::Symbolize(addr[i], std::data(name), std::size(name));
-      if (result) {
-        symbol = std::data(name);
-      }
-      fmt::println(stderr, "[{:2}] {} {}", i, addr[i], symbol);
-    }
+// note! async-signal-safe (lock-free atomic)
+void verbosity_signal_handler(int sig) {
+  if (sig == SIGUSR1) {
+    verbosity.fetch_add(1, std::memory_order_relaxed);
   } else {
-    fmt::println(stderr, "can't get stacktrace");
+    auto current = verbosity.load(std::memory_order_relaxed);
+    while (current > 0 && !verbosity.compare_exchange_weak(current, current - 1, std::memory_order_relaxed)) {
+    }
   }
-  invoke_default_signal_handler(sig);
 }
 
-void install_failure_signal_handler() {
+void install_verbosity_signal_handler() {
+  static_assert(std::atomic<size_t>::is_always_lock_free);
   struct sigaction action = {};
-  action.sa_sigaction = termination_handler;
-  action.sa_flags = SA_SIGINFO;
-  sigaction(SIGABRT, &action, nullptr);
-  sigaction(SIGILL, &action, nullptr);
-  sigaction(SIGSEGV, &action, nullptr);
+  action.sa_handler = verbosity_signal_handler;
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGUSR1, &action, nullptr);
+  sigaction(SIGUSR2, &action, nullptr);
 }
 }  // namespace
 
@@ -104,11 +79,48 @@ Logger::Logger(args::Parser const &args, logging::Settings const &settings, bool
   } else {
     verbosity = settings.log.verbosity;
   }
+  // vmodule
+  auto vmodule = std::getenv("ROQ_vmodule");
+  try {
+    if (vmodule != nullptr && std::strlen(vmodule) > 0) {
+      set_vmodule(vmodule);
+    } else {
+      set_vmodule(settings.log.vmodule);
+    }
+  } catch (RuntimeError &e) {
+    fmt::println(stderr, "{}"sv, e.what());
+    std::exit(EXIT_FAILURE);
+  }
+  // structured logging
+  if (std::empty(settings.log.structured_format) || settings.log.structured_format == "logfmt"sv) {
+    structured_encoding = Encoding::LOGFMT;
+  } else if (settings.log.structured_format == "json"sv) {
+    structured_encoding = Encoding::JSON;
+  } else {
+    fmt::println(stderr, R"(Unknown structured format: "{}")"sv, settings.log.structured_format);
+    std::exit(EXIT_FAILURE);
+  }
+  // metrics
+  metrics = settings.log.metrics || settings.log.metrics_freq.count() != 0;
+  // termination
+  if (settings.log.drain_timeout.count() != 0) {
+    drain_timeout = settings.log.drain_timeout;
+  }
+  // runtime changes
+  if (settings.log.verbosity_signals) {
+    install_verbosity_signal_handler();
+  }
+  if (!std::empty(settings.log.control_file)) {
+    control_ = std::make_unique<Control>(settings.log.control_file);
+  }
   // stacktrace
   if (stacktrace) {
-    install_failure_signal_handler();
+    install_crash_handler(settings.log.path);
   }
 }
 
+Logger::~Logger() {
+}
+
 }  // namespace logging
 }  // namespace roq
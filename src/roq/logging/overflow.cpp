@@ -0,0 +1,68 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/overflow.hpp"
+
+#include <fmt/format.h>
+
+#include "roq/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+
+// === IMPLEMENTATION ===
+
+Overflow get_overflow(Settings const &settings) {
+  auto &overflow_policy = settings.log.overflow_policy;
+  if (std::empty(overflow_policy) || overflow_policy == "block"sv) {
+    return Overflow::BLOCK;
+  }
+  if (overflow_policy == "drop_newest"sv) {
+    return Overflow::DROP_NEWEST;
+  }
+  if (overflow_policy == "drop_oldest"sv) {
+    return Overflow::DROP_OLDEST;
+  }
+  if (overflow_policy == "drop_below_level"sv) {
+    return Overflow::DROP_BELOW_LEVEL;
+  }
+  throw RuntimeError{R"(Unknown overflow policy: "{}")"sv, overflow_policy};
+}
+
+bool Dropped::empty() const {
+  for (size_t i = 0; i < std::size(counters_); ++i) {
+    if (counters_[i].load(std::memory_order_relaxed) != reported_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string Dropped::take() {
+  std::string details;
+  auto total = 0uz;
+  for (size_t i = 0; i < std::size(counters_); ++i) {
+    auto counter = counters_[i].load(std::memory_order_relaxed);
+    auto count = counter - reported_[i];
+    if (count == 0) {
+      continue;
+    }
+    reported_[i] = counter;
+    total += count;
+    fmt::format_to(std::back_inserter(details), "{}{}={}"sv, std::empty(details) ? ""sv : ", "sv, magic_enum::enum_name(static_cast<Level>(i)), count);
+  }
+  if (total == 0) {
+    return {};
+  }
+  return fmt::format("*** DROPPED {} MESSAGE(S) ({}) ***"sv, total, details);
+}
+
+void Dropped::get(Stats &stats) const {
+  for (size_t i = 0; i < std::size(counters_); ++i) {
+    stats.dropped[i] = counters_[i].load(std::memory_order_relaxed);
+  }
+}
+
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,53 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "roq/logging/level.hpp"
+#include "roq/logging/settings.hpp"
+#include "roq/logging/stats.hpp"
+
+namespace roq {
+namespace logging {
+
+// overflow policy (what a producer does when the asynchronous queue is full)
+enum class Overflow {
+  BLOCK,
+  DROP_NEWEST,
+  DROP_OLDEST,
+  DROP_BELOW_LEVEL,  // note! blocks for WARNING and above
+};
+
+Overflow get_overflow(Settings const &);
+
+inline bool is_blocking(Overflow overflow, Level level) {
+  return overflow == Overflow::BLOCK || (overflow == Overflow::DROP_BELOW_LEVEL && level >= Level::WARNING);
+}
+
+// drop accounting (per level)
+// note! counting is thread-safe, reporting must be done by one thread at a time
+struct Dropped final {
+  void operator()(Level level) { counters_[static_cast<size_t>(level)].fetch_add(1, std::memory_order_relaxed); }
+
+  // note! nothing dropped since last reported
+  bool empty() const;
+
+  // note! returns the synthetic warning for what was dropped since last reported, e.g. "*** DROPPED 12 MESSAGE(S) (DEBUG=10, INFO=2) ***"
+  std::string take();
+
+  // note! cumulative
+  void get(Stats &) const;
+
+ private:
+  std::array<std::atomic<uint64_t>, magic_enum::enum_count<Level>()> counters_ = {};
+  std::array<uint64_t, magic_enum::enum_count<Level>()> reported_ = {};
+};
+
+}  // namespace logging
+}  // namespace roq
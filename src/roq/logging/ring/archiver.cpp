@@ -0,0 +1,231 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/archiver.hpp"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "roq/logging/ring/compressor.hpp"
+#include "roq/logging/ring/files.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === CONSTANTS ===
+
+namespace {
+auto const CHUNK_SIZE = 1048576uz;
+auto const SUFFIX = ".zst"sv;
+auto const PENDING = ".pending"sv;
+constexpr auto const MAGIC = "\x28\xb5\x2f\xfd"sv;  // note! zstd frame (little-endian)
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+bool write_all(int fd, std::string_view const &buffer) {
+  auto remaining = buffer;
+  while (!std::empty(remaining)) {
+    auto result = ::write(fd, std::data(remaining), std::size(remaining));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    remaining.remove_prefix(result);
+  }
+  return true;
+}
+
+// note! streaming compression, the file may have been staged by a previous process using different settings
+bool is_compressed(std::string const &path) {
+  auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  std::array<char, std::size(MAGIC)> buffer;
+  auto length = ::read(fd, std::data(buffer), std::size(buffer));
+  ::close(fd);
+  return length == std::ssize(buffer) && std::string_view{std::data(buffer), std::size(buffer)} == MAGIC;
+}
+
+// note! "{pid}.{sequence}"
+bool is_staged(std::string_view const &value) {
+  auto dot = value.find('.');
+  if (dot == 0 || dot == value.npos || (dot + 1) == std::size(value)) {
+    return false;
+  }
+  auto is_digit = [](auto c) { return c >= '0' && c <= '9'; };
+  return std::all_of(std::begin(value), std::begin(value) + dot, is_digit) && std::all_of(std::begin(value) + dot + 1, std::end(value), is_digit);
+}
+
+// note! files staged by a previous process (which may have crashed or failed to compress), oldest first
+auto get_stale(std::string_view const &path) {
+  std::filesystem::path tmp{path};
+  auto directory = tmp.has_parent_path() ? tmp.parent_path() : std::filesystem::path{"."};
+  auto prefix = fmt::format("{}."sv, tmp.filename().native());
+  std::vector<std::pair<std::filesystem::file_time_type, std::string>> files;
+  std::error_code error;
+  for (std::filesystem::directory_iterator iter{directory, error}, end; !error && iter != end; iter.increment(error)) {
+    auto filename = (*iter).path().filename().native();
+    std::string_view name{filename};
+    if (!name.starts_with(prefix) || !name.ends_with(PENDING) || !is_staged(name.substr(std::size(prefix), std::size(name) - std::size(prefix) - std::size(PENDING)))) {
+      continue;
+    }
+    auto last_write_time = (*iter).last_write_time(error);
+    if (error) {
+      error.clear();
+      continue;
+    }
+    files.emplace_back(last_write_time, (*iter).path().native());
+  }
+  std::sort(std::begin(files), std::end(files));
+  std::deque<std::string> result;
+  for (auto &[_, file] : files) {
+    result.emplace_back(std::move(file));
+  }
+  return result;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Archiver::Archiver(std::string_view const &path, size_t max_files, int32_t level)
+    : path_{path}, max_files_{max_files}, level_{level}, jobs_{get_stale(path)}, thread_{[this]() { run(); }} {
+}
+
+std::unique_ptr<Archiver> Archiver::create(Settings const &settings) {
+  if (!Compressor::is_enabled(settings.log.compression_rotated)) {
+    return {};
+  }
+  Compressor{settings.log.compression_level};  // note! validate (before the thread is started)
+  return std::make_unique<Archiver>(settings.log.path, settings.log.max_files, settings.log.compression_level);
+}
+
+Archiver::~Archiver() {
+  {
+    std::lock_guard lock{mutex_};
+    stop_ = true;
+  }
+  condition_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void Archiver::operator()() {
+  auto staged = fmt::format("{}.{}.{}.pending"sv, path_, ::getpid(), ++sequence_);
+  if (::rename(path_.c_str(), staged.c_str()) < 0) {
+    return;  // note! nowhere to report
+  }
+  {
+    std::lock_guard lock{mutex_};
+    jobs_.emplace_back(std::move(staged));
+  }
+  condition_.notify_one();
+}
+
+void Archiver::run() {
+  // note! best effort
+  struct sched_param param = {};
+  ::sched_setscheduler(0, SCHED_IDLE, &param);
+  std::deque<std::string> failed;  // note! retried (in order) before the next job
+  while (true) {
+    {
+      std::unique_lock lock{mutex_};
+      condition_.wait(lock, [this]() { return stop_ || !std::empty(jobs_); });
+      if (std::empty(jobs_)) {
+        return;  // note! failed files are kept (swept by the next process)
+      }
+      failed.emplace_back(std::move(jobs_.front()));
+      jobs_.pop_front();
+    }
+    while (!std::empty(failed) && process(failed.front())) {
+      failed.pop_front();
+    }
+  }
+}
+
+// note! returns false if the staged file must be kept (and retried)
+bool Archiver::process(std::string const &staged) {
+  if (!exists(staged)) {
+    return true;
+  }
+  if (max_files_ == 0) {
+    ::unlink(staged.c_str());
+    return true;
+  }
+  auto target = fmt::format("{}{}"sv, path_, SUFFIX);
+  if (is_compressed(staged)) {
+    if (::rename(staged.c_str(), target.c_str()) < 0) {
+      return false;
+    }
+  } else {
+    if (!compress(staged, target)) {
+      ::unlink(target.c_str());
+      return false;
+    }
+    ::unlink(staged.c_str());
+  }
+  rotate_files(path_, max_files_, SUFFIX);
+  return true;
+}
+
+bool Archiver::compress(std::string const &source, std::string const &target) {
+  auto input = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+  if (input < 0) {
+    return false;
+  }
+  auto output = ::open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (output < 0) {
+    ::close(input);
+    return false;
+  }
+  auto result = true;
+  try {
+    Compressor compressor{level_};
+    std::string buffer(CHUNK_SIZE, '\0');
+    std::string compressed;
+    while (result) {
+      auto length = ::read(input, std::data(buffer), std::size(buffer));
+      if (length < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        result = false;
+        break;
+      }
+      compressed.clear();
+      std::string_view chunk{std::data(buffer), static_cast<size_t>(length)};
+      compressor(chunk, compressed, length == 0 ? Compressor::Mode::END : Compressor::Mode::CONTINUE);
+      result = write_all(output, compressed);
+      if (length == 0) {
+        break;
+      }
+    }
+  } catch (...) {
+    result = false;
+  }
+  ::close(input);
+  ::close(output);
+  return result;
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
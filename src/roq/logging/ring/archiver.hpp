@@ -0,0 +1,59 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "roq/logging/settings.hpp"
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// background compression of rotated files
+// - a low priority (SCHED_IDLE) helper thread compresses the files (zstd) and then shifts the rotated files
+// - rotated files are named "path/name.1.ext.zst", "path/name.2.ext.zst", etc.
+// note! the helper thread owns the naming of the rotated files (rotation can't race with compression)
+// note! files already compressed (streaming compression) are only renamed (detected by the zstd magic number)
+// note! files failing to compress are retried before the next file, files staged by a previous process are swept when created
+struct Archiver final {
+  Archiver(std::string_view const &path, size_t max_files, int32_t level);
+
+  Archiver(Archiver const &) = delete;
+
+  // note! returns nullptr if background compression has not been enabled
+  static std::unique_ptr<Archiver> create(Settings const &);
+
+  // note! completes all pending jobs
+  ~Archiver();
+
+  // note! the caller must have closed the file, it is renamed (staged) before this returns
+  void operator()();
+
+ protected:
+  void run();
+  bool process(std::string const &staged);
+  bool compress(std::string const &source, std::string const &target);
+
+ private:
+  std::string const path_;
+  size_t const max_files_;
+  int32_t const level_;
+  uint64_t sequence_ = {};
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::string> jobs_;
+  bool stop_ = {};
+  std::thread thread_;  // note! last
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
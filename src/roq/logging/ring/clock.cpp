@@ -0,0 +1,129 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/clock.hpp"
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === CONSTANTS ===
+
+namespace {
+auto const CALIBRATION_PERIOD = 5ms;  // note! initial (blocking) calibration
+auto const SAMPLE_ATTEMPTS = 5uz;
+auto const SMOOTHING = 0.1;  // note! weight of the latest tick rate measurement
+auto const MAX_SLEW = 0.0005;  // note! same as ntp (500 ppm), converted timestamps therefore still move forward
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+int64_t get_time(clockid_t clock_id) {
+  struct timespec time = {};
+  ::clock_gettime(clock_id, &time);
+  return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+bool has_invariant_tsc() {
+#if defined(__x86_64__)
+  unsigned int eax = {}, ebx = {}, ecx = {}, edx = {};
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) {
+    return false;
+  }
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Clock::Clock() : tsc_{has_invariant_tsc()} {
+  if (!tsc_) {
+    return;
+  }
+  auto first = sample();
+  auto end = first.monotonic + std::chrono::nanoseconds{CALIBRATION_PERIOD}.count();
+  auto second = first;
+  while (second.monotonic < end) {
+    second = sample();
+  }
+  scale_ = static_cast<double>(second.monotonic - first.monotonic) / static_cast<double>(second.ticks - first.ticks);
+  base_ticks_ = second.ticks;
+  base_monotonic_ = second.monotonic;
+  offset_ = second.realtime - second.monotonic;
+  previous_ = second;
+}
+
+// note! the rebased estimate is continuous (or moves forward to the measured value), the scale and slew then apply from here
+// note! the slew assumes the next re-calibration happens after the same period (the remaining error is then corrected)
+void Clock::calibrate() {
+  if (!tsc_) {
+    return;
+  }
+  auto current = sample();
+  if (current.ticks <= previous_.ticks || current.monotonic <= previous_.monotonic) {
+    return;
+  }
+  auto estimate = get_monotonic(current.ticks);
+  auto rate = static_cast<double>(current.monotonic - previous_.monotonic) / static_cast<double>(current.ticks - previous_.ticks);
+  scale_ += SMOOTHING * (rate - scale_);
+  auto base_monotonic = std::max(estimate, current.monotonic);
+  auto offset = get_offset(base_monotonic);
+  auto error = (current.realtime - current.monotonic) - offset;
+  base_ticks_ = current.ticks;
+  base_monotonic_ = base_monotonic;
+  if (error >= 0) {
+    offset_ = offset + error;
+    slew_ = {};
+  } else {
+    auto period = static_cast<double>(current.monotonic - previous_.monotonic);
+    offset_ = offset;
+    slew_ = std::max(static_cast<double>(error) / period, -MAX_SLEW);
+  }
+  previous_ = current;
+}
+
+// note! the tightest bracket (rdtsc, clock_gettime x2, rdtsc) of a few attempts
+Clock::Sample Clock::sample() {
+  Sample result;
+#if defined(__x86_64__)
+  auto best = std::numeric_limits<uint64_t>::max();
+  for (size_t i = 0; i < SAMPLE_ATTEMPTS; ++i) {
+    auto before = __rdtsc();
+    auto monotonic = get_time(CLOCK_MONOTONIC_RAW);
+    auto realtime = get_time(CLOCK_REALTIME);
+    auto after = __rdtsc();
+    if ((after - before) < best) {
+      best = after - before;
+      result = {
+          .ticks = before + (after - before) / 2,
+          .monotonic = monotonic,
+          .realtime = realtime,
+      };
+    }
+  }
+#else
+  result.monotonic = get_time(CLOCK_MONOTONIC_RAW);
+  result.realtime = get_time(CLOCK_REALTIME);
+  result.ticks = static_cast<uint64_t>(result.monotonic);
+#endif
+  return result;
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,92 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// timestamp capture
+// - producers capture raw ticks (rdtsc if the cpu has an invariant tsc, otherwise CLOCK_REALTIME nanoseconds)
+// - the backend converts ticks to wall-clock time
+// - the tick rate is measured against CLOCK_MONOTONIC_RAW (not subject to ntp) and smoothed when re-calibrating
+// - the wall-clock is a separate offset (CLOCK_REALTIME - CLOCK_MONOTONIC_RAW) tracking the measured offset
+//   - moving forward is applied immediately
+//   - moving backward is slewed (bounded rate) until the next re-calibration
+// - calibrated on construction and then periodically re-calibrated by the backend
+// note! ticks are comparable across threads (invariant tsc is synchronized across cores)
+// note! converted timestamps never go backwards (a wall-clock stepped back by ntp is followed at the bounded slew rate)
+
+struct ROQ_PUBLIC Clock final {
+  Clock();
+
+  Clock(Clock const &) = delete;
+
+  // producer (any thread)
+  uint64_t now() const {
+#if defined(__x86_64__)
+    if (tsc_) [[likely]] {
+      return __rdtsc();
+    }
+#endif
+    return get_realtime();
+  }
+
+  // backend
+  std::chrono::nanoseconds operator()(uint64_t ticks) const {
+    if (!tsc_) {
+      return std::chrono::nanoseconds{ticks};
+    }
+    auto monotonic = get_monotonic(ticks);
+    return std::chrono::nanoseconds{monotonic + get_offset(monotonic)};
+  }
+
+  void calibrate();
+
+  bool tsc() const { return tsc_; }
+
+ protected:
+  static uint64_t get_realtime() {
+    struct timespec time = {};
+    ::clock_gettime(CLOCK_REALTIME, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+  }
+
+  int64_t get_monotonic(uint64_t ticks) const {
+    auto delta = static_cast<int64_t>(ticks - base_ticks_);
+    return base_monotonic_ + static_cast<int64_t>(static_cast<double>(delta) * scale_);
+  }
+
+  int64_t get_offset(int64_t monotonic) const { return offset_ + static_cast<int64_t>(static_cast<double>(monotonic - base_monotonic_) * slew_); }
+
+  struct Sample final {
+    uint64_t ticks = {};
+    int64_t monotonic = {};
+    int64_t realtime = {};
+  };
+
+  static Sample sample();
+
+ private:
+  bool const tsc_;
+  uint64_t base_ticks_ = {};
+  int64_t base_monotonic_ = {};
+  double scale_ = 1.0;  // note! nanoseconds per tick
+  int64_t offset_ = {};  // note! realtime - monotonic (at base)
+  double slew_ = {};     // note! offset change per nanosecond (never less than minus the max slew rate)
+  Sample previous_;      // note! last calibration (measured)
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
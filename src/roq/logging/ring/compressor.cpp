@@ -0,0 +1,118 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/compressor.hpp"
+
+#if defined(ROQ_LOGGING_ZSTD)
+#include <zstd.h>
+#endif
+
+#include "roq/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === HELPERS ===
+
+namespace {
+#if defined(ROQ_LOGGING_ZSTD)
+auto create_context(auto level) {
+  if (level < ZSTD_minCLevel() || level > ZSTD_maxCLevel()) {
+    throw RuntimeError{"Invalid compression level: {} (expected {}-{})"sv, level, ZSTD_minCLevel(), ZSTD_maxCLevel()};
+  }
+  auto result = ZSTD_createCCtx();
+  if (result == nullptr) {
+    throw RuntimeError{"Unable to create compression context"sv};
+  }
+  auto error = ZSTD_CCtx_setParameter(result, ZSTD_c_compressionLevel, level);
+  if (ZSTD_isError(error)) {
+    ZSTD_freeCCtx(result);
+    throw RuntimeError{R"(Unable to set compression level: error="{}")"sv, ZSTD_getErrorName(error)};
+  }
+  return result;
+}
+
+constexpr auto get_directive(Compressor::Mode mode) {
+  switch (mode) {
+    using enum Compressor::Mode;
+    case CONTINUE:
+      return ZSTD_e_continue;
+    case FLUSH:
+      return ZSTD_e_flush;
+    case END:
+      return ZSTD_e_end;
+  }
+  return ZSTD_e_continue;
+}
+#else
+// note! built without zstd (ROQ_LOGGING_ZSTD)
+[[noreturn]] void not_supported() {
+  throw RuntimeError{"Compression is not supported (built without zstd)"sv};
+}
+
+ZSTD_CCtx_s *create_context(auto) {
+  not_supported();
+}
+#endif
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Compressor::Compressor(int32_t level) : context_{create_context(level)} {
+}
+
+bool Compressor::is_enabled(std::string_view const &codec) {
+  if (std::empty(codec) || codec == "none"sv) {
+    return false;
+  }
+  if (codec == "zstd"sv) {
+#if !defined(ROQ_LOGGING_ZSTD)
+    not_supported();
+#endif
+    return true;
+  }
+  throw RuntimeError{R"(Unknown compression: "{}")"sv, codec};
+}
+
+Compressor::~Compressor() {
+#if defined(ROQ_LOGGING_ZSTD)
+  ZSTD_freeCCtx(context_);
+#endif
+}
+
+void Compressor::operator()([[maybe_unused]] std::string_view const &input, [[maybe_unused]] std::string &output, [[maybe_unused]] Mode mode) {
+#if defined(ROQ_LOGGING_ZSTD)
+  auto directive = get_directive(mode);
+  ZSTD_inBuffer in{
+      .src = std::data(input),
+      .size = std::size(input),
+      .pos = 0,
+  };
+  while (true) {
+    auto offset = std::size(output);
+    output.resize(offset + ZSTD_CStreamOutSize());
+    ZSTD_outBuffer out{
+        .dst = std::data(output) + offset,
+        .size = std::size(output) - offset,
+        .pos = 0,
+    };
+    auto remaining = ZSTD_compressStream2(context_, &out, &in, directive);
+    output.resize(offset + out.pos);
+    if (ZSTD_isError(remaining)) {
+      throw RuntimeError{R"(Unable to compress: error="{}")"sv, ZSTD_getErrorName(remaining)};
+    }
+    // note! flush and end must continue until the internal buffers have been emptied
+    if (mode == Mode::CONTINUE ? in.pos == in.size : remaining == 0) {
+      break;
+    }
+  }
+#else
+  not_supported();
+#endif
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
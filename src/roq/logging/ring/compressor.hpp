@@ -0,0 +1,42 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct ZSTD_CCtx_s;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// streaming compression (zstd frame format)
+// note! not thread-safe
+struct Compressor final {
+  enum class Mode {
+    CONTINUE,  // note! may buffer internally
+    FLUSH,     // note! output can be decompressed up to this point
+    END,       // note! completes the frame
+  };
+
+  explicit Compressor(int32_t level);
+
+  // note! validates the codec name (one of: "", none, zstd)
+  static bool is_enabled(std::string_view const &codec);
+
+  Compressor(Compressor const &) = delete;
+
+  ~Compressor();
+
+  // note! appends to output
+  void operator()(std::string_view const &input, std::string &output, Mode);
+
+ private:
+  ZSTD_CCtx_s *const context_;
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,53 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/files.hpp"
+
+#include <unistd.h>
+
+#include <sys/stat.h>
+
+#include <cstdio>
+
+#include <fmt/format.h>
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === IMPLEMENTATION ===
+
+std::string get_filename(std::string_view const &path, size_t index) {
+  if (index == 0) {
+    return std::string{path};
+  }
+  auto separator = path.find_last_of('/');
+  auto dot = path.find_last_of('.');
+  // note! no extension, hidden file or dot in directory name
+  if (dot == path.npos || dot == 0 || (separator != path.npos && dot <= (separator + 1))) {
+    return fmt::format("{}.{}"sv, path, index);
+  }
+  return fmt::format("{}.{}{}"sv, path.substr(0, dot), index, path.substr(dot));
+}
+
+bool exists(std::string const &path) {
+  struct stat buffer = {};
+  return ::stat(path.c_str(), &buffer) == 0;
+}
+
+void rotate_files(std::string_view const &path, size_t max_files, std::string_view const &suffix) {
+  for (auto i = max_files; i > 0; --i) {
+    auto source = get_filename(path, i - 1).append(suffix);
+    if (!exists(source)) {
+      continue;
+    }
+    auto target = get_filename(path, i).append(suffix);
+    ::unlink(target.c_str());
+    ::rename(source.c_str(), target.c_str());
+  }
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,22 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// note! same naming convention as spdlog: "path/name.ext" --> "path/name.1.ext", "path/name.2.ext", etc.
+std::string get_filename(std::string_view const &path, size_t index);
+
+bool exists(std::string const &path);
+
+// note! shifts "path" --> "path.1" --> "path.2" etc. (discarding anything beyond max_files), suffix is appended to all names
+void rotate_files(std::string_view const &path, size_t max_files, std::string_view const &suffix = {});
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
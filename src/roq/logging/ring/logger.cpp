@@ -0,0 +1,712 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/logger.hpp"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+
+#include <fmt/format.h>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/shared.hpp"
+#include "roq/logging/sinks.hpp"
+
+#include "roq/logging/ring/compressor.hpp"
+#include "roq/logging/ring/mapped_file.hpp"
+#include "roq/logging/ring/rotating_file.hpp"
+#include "roq/logging/ring/stream.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === CONSTANTS ===
+
+namespace {
+auto const QUEUE_CAPACITY = 1048576uz;
+auto const MIN_QUEUE_CAPACITY = 4096uz;
+auto const MAX_QUEUE_CAPACITY = 2 * uint64_t{UINT32_MAX};  // note! the record length (at most half the capacity) is stored as uint32_t
+auto const MAX_BATCH_SIZE = 1024uz;
+auto const RESERVE_LENGTH = 512uz;  // note! two-phase, longer messages will fall back to the message buffer (and are then written with exact length)
+auto const IDLE_SLEEP = 100us;
+auto const CALIBRATION_FREQ = 1s;
+auto const DROPPED_REPORT_FREQ = 1s;
+auto const DRAIN_SLEEP = 100us;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+std::atomic<uint64_t> GENERATION;  // note! incremented for each new logger (0 means "none")
+std::atomic<uint64_t> CURRENT;     // note! generation of the live logger
+
+auto get_wait(auto &settings) {
+  auto &wait_strategy = settings.log.wait_strategy;
+  if (std::empty(wait_strategy) || wait_strategy == "sleep"sv) {
+    return Logger::Wait::SLEEP;
+  }
+  if (wait_strategy == "spin"sv) {
+    return Logger::Wait::SPIN;
+  }
+  if (wait_strategy == "yield"sv) {
+    return Logger::Wait::YIELD;
+  }
+  if (wait_strategy == "block"sv) {
+    return Logger::Wait::BLOCK;
+  }
+  throw RuntimeError{R"(Unknown wait strategy: "{}")"sv, wait_strategy};
+}
+
+auto get_queue_capacity(auto &settings) {
+  auto result = settings.log.queue_capacity;
+  if (result == 0) {
+    return QUEUE_CAPACITY;
+  }
+  if (result < MIN_QUEUE_CAPACITY) {
+    throw RuntimeError{"Invalid queue capacity: {} (min is {})"sv, result, MIN_QUEUE_CAPACITY};
+  }
+  if (result > MAX_QUEUE_CAPACITY) {
+    throw RuntimeError{"Invalid queue capacity: {} (max is {})"sv, result, MAX_QUEUE_CAPACITY};
+  }
+  return static_cast<size_t>(result);
+}
+
+// note! producers can't discard the oldest message (they don't own the read index of the queue)
+auto get_overflow_policy(auto &settings) {
+  auto result = get_overflow(settings);
+  if (result == Overflow::DROP_OLDEST) {
+    throw RuntimeError{R"(Overflow policy is not supported by the ring logger: "{}")"sv, settings.log.overflow_policy};
+  }
+  return result;
+}
+
+// note! the futex word is the waiting flag (signal-tolerant)
+long futex(std::atomic<uint32_t> &value, int operation, uint32_t expected, struct timespec const *timeout) {
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free);
+  return ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&value), operation, expected, timeout, nullptr, 0);
+}
+
+void cpu_relax() {
+#if defined(__x86_64__)
+  __builtin_ia32_pause();
+#endif
+}
+
+// note! thread-local binding between the producer thread and its queue
+struct Local final {
+  Local() : thread_id{static_cast<uint32_t>(::gettid())} {}
+
+  ~Local() {
+    if (producer != nullptr && !shared && generation == CURRENT.load(std::memory_order_acquire)) {
+      (*producer).released.store(true, std::memory_order_release);
+    }
+  }
+
+  uint32_t const thread_id;
+  uint64_t generation = {};
+  Logger::Producer *producer = nullptr;
+  bool shared = {};
+  bool dropped = {};
+  Level dropped_level = {};  // note! counted when released (a discarded reserve is retried by the caller)
+  std::vector<std::byte> scratch;  // note! dropped messages
+};
+
+thread_local Local LOCAL;
+
+auto create_sink(auto &settings) -> std::unique_ptr<Sink> {
+  if (std::empty(settings.log.path)) {
+    if (Compressor::is_enabled(settings.log.compression)) {
+      throw RuntimeError{"Compression requires a log path"sv};
+    }
+    return std::make_unique<Stream>(STDOUT_FILENO);
+  }
+  if (settings.log.mmap) {
+    if (Compressor::is_enabled(settings.log.compression)) {
+      throw RuntimeError{"Compression is not supported by memory-mapped file"sv};
+    }
+    return std::make_unique<MappedFile>(settings);
+  }
+  return std::make_unique<RotatingFile>(settings);
+}
+
+auto create_sink(auto &settings, SinkOptions const &options) -> std::unique_ptr<Sink> {
+  switch (options.type) {
+    using enum SinkOptions::Type;
+    case STDOUT:
+      return std::make_unique<Stream>(STDOUT_FILENO);
+    case STDERR:
+      return std::make_unique<Stream>(STDERR_FILENO);
+    case FILE: {
+      // note! compression and archiving only apply to the primary sink
+      auto tmp = settings;
+      tmp.log.path = options.path;
+      tmp.log.compression = {};
+      tmp.log.compression_rotated = {};
+      return std::make_unique<RotatingFile>(tmp);
+    }
+  }
+  return std::unique_ptr<Sink>{};
+}
+
+// note! primary sink first (receives all messages)
+auto create_outputs(auto &settings) {
+  auto sinks = get_sinks(settings);
+  if (!std::empty(sinks) && settings.log.format == "binary"sv) {
+    throw RuntimeError{"Additional sinks are not supported by binary format"sv};
+  }
+  std::vector<Logger::Output> result;
+  auto add = [&](auto &&sink, auto level) {
+    auto color = terminal_color && (*sink).terminal();
+    result.push_back({.sink = std::move(sink), .level = level, .color = color});
+  };
+  add(create_sink(settings), Level::DEBUG);
+  for (auto &item : sinks) {
+    add(create_sink(settings, item), item.level);
+  }
+  return result;
+}
+
+auto create_encoder(auto &settings, auto &metadata) -> std::unique_ptr<binary::Encoder> {
+  if (settings.log.format != "binary"sv) {
+    return {};
+  }
+  if (std::empty(settings.log.path)) {
+    throw RuntimeError{"Binary format requires a log path"sv};
+  }
+  return std::make_unique<binary::Encoder>(metadata);
+}
+
+auto now() {
+  struct timespec time = {};
+  ::clock_gettime(CLOCK_REALTIME, &time);
+  return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Logger::Logger(Settings const &settings, Metadata const &metadata)
+    : Handler{true}, generation_{++GENERATION}, flush_freq_{settings.log.flush_freq}, outputs_{create_outputs(settings)}, encoder_{create_encoder(settings, metadata)},
+      deferred_{settings.log.deferred || encoder_}, thread_options_{settings}, wait_{get_wait(settings)},
+      wait_spin_count_{settings.log.wait_spin_count}, wait_yield_count_{settings.log.wait_yield_count},
+      queue_capacity_{get_queue_capacity(settings)}, overflow_{get_overflow_policy(settings)}, metrics_freq_{settings.log.metrics_freq},
+      pattern_{std::empty(settings.log.pattern) ? Pattern::DEFAULT : settings.log.pattern}, thread_{[this]() { run(); }} {
+  CURRENT.store(generation_, std::memory_order_release);
+  (*this)(Level::INFO, "logging: async (ring)"sv);
+}
+
+Logger::~Logger() {
+  CURRENT.store(0, std::memory_order_release);
+  stop_.store(true, std::memory_order_release);
+  if (wait_ == Wait::BLOCK) {
+    wake();
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void Logger::operator()(Level level, std::string_view const &message) {
+  auto buffer = acquire(get_queue(), level, std::size(message));
+  auto length = std::min(std::size(message), std::size(buffer));
+  std::memcpy(std::data(buffer), std::data(message), length);
+  release(length);
+}
+
+// note! shared producers must not hold the lock while the caller is formatting (the formatter may throw)
+std::span<char> Logger::reserve(Level level) {
+  auto &queue = get_queue();
+  if (LOCAL.shared) [[unlikely]] {
+    return {};
+  }
+  auto buffer = acquire(queue, level, RESERVE_LENGTH);
+  return {reinterpret_cast<char *>(std::data(buffer)), std::size(buffer)};
+}
+
+void Logger::commit(Level, size_t length) {
+  release(length, length == 0);
+}
+
+// note! shared producers hold the lock while the caller copies the arguments (trivially copyable, can't throw)
+std::span<std::byte> Logger::reserve_deferred(Level level, Codec const &codec, size_t length) {
+  if (!deferred_) {
+    return {};
+  }
+  auto buffer = acquire(get_queue(), level, length, &codec);
+  if (std::size(buffer) < length) [[unlikely]] {
+    release(0, true);
+    return {};
+  }
+  return buffer;
+}
+
+// note! signal-tolerant: only atomics, pthread_self, clock_gettime, futex and nanosleep
+// note! the backend thread can't wait for itself
+// note! messages committed by other threads while draining may prevent the queues from ever becoming empty (we will then time out)
+// note! the calling thread may have crashed while formatting (its reservation would otherwise hold back all newer records)
+bool Logger::drain(std::chrono::nanoseconds timeout, bool) {
+  if (std::this_thread::get_id() == thread_.get_id()) {
+    return false;
+  }
+  if (LOCAL.generation == generation_ && !LOCAL.shared) {
+    (*LOCAL.producer).reserved_at.store(0, std::memory_order_release);
+  }
+  auto deadline = detail::Metrics::now() + static_cast<uint64_t>(timeout.count());
+  uint64_t request = {};
+  while (true) {
+    // note! flush is requested once the queues have been seen as empty (the backend then flushes after having written everything)
+    if (empty()) {
+      if (request == 0) {
+        request = flush_request_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (wait_ == Wait::BLOCK) {
+          wake();
+        }
+      } else if (flushed_.load(std::memory_order_acquire) >= request) {
+        return true;
+      }
+    }
+    if (detail::Metrics::now() >= deadline) {
+      return false;
+    }
+    struct timespec sleep = {
+        .tv_sec = 0,
+        .tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(DRAIN_SLEEP).count(),
+    };
+    ::nanosleep(&sleep, nullptr);
+  }
+}
+
+Stats Logger::get_stats() const {
+  auto result = Handler::get_stats();
+  dropped_.get(result);
+  result.queue_depth = stats_.queue_depth.load(std::memory_order_relaxed);
+  result.queue_depth_max = stats_.queue_depth_max.load(std::memory_order_relaxed);
+  result.write_count = stats_.write_count.load(std::memory_order_relaxed);
+  result.write_time = std::chrono::nanoseconds{stats_.write_time.load(std::memory_order_relaxed)};
+  result.flush_count = stats_.flush_count.load(std::memory_order_relaxed);
+  result.flush_time = std::chrono::nanoseconds{stats_.flush_time.load(std::memory_order_relaxed)};
+  return result;
+}
+
+// note! returned buffer may be smaller than requested (we truncate when exceeding the max record length of the queue)
+// note! the queue must have been resolved (get_queue) by the calling thread
+// note! the reservation is announced before blocking (the backend thread must hold back newer records from other queues)
+// note! shared producers announce under the lock, another thread may replace it while we're blocked (ordering is then best effort)
+std::span<std::byte> Logger::acquire(Queue &queue, Level level, size_t length, Codec const *codec) {
+  LOCAL.dropped = false;  // note! a previous reserve may never have been committed (the formatter may throw)
+  if (LOCAL.shared) [[unlikely]] {
+    mutex_.lock();
+  }
+  auto timestamp = clock_.now();
+  auto &reserved_at = (*LOCAL.producer).reserved_at;
+  auto total = std::min(sizeof(Header) + length, queue.max_length());
+  while (true) {
+    reserved_at.store(timestamp, std::memory_order_release);
+    auto buffer = queue.try_reserve(total);
+    if (!std::empty(buffer)) [[likely]] {
+      new (std::data(buffer)) Header{
+          .timestamp = timestamp,
+          .codec = codec,
+          .thread_id = LOCAL.thread_id,
+          .level = level,
+      };
+      return buffer.subspan(sizeof(Header));
+    }
+    // note! queue is full
+    if (!is_blocking(overflow_, level)) [[unlikely]] {
+      return drop(level, total - sizeof(Header));
+    }
+    // note! we block until the backend has made room (shared producers release the lock while waiting, it is also needed to register producers)
+    if (LOCAL.shared) [[unlikely]] {
+      mutex_.unlock();
+      std::this_thread::yield();
+      mutex_.lock();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// note! the caller will write to the returned buffer (and must then call release)
+std::span<std::byte> Logger::drop(Level level, size_t length) {
+  (*LOCAL.producer).reserved_at.store(0, std::memory_order_release);
+  if (LOCAL.shared) [[unlikely]] {
+    mutex_.unlock();
+  }
+  LOCAL.dropped = true;
+  LOCAL.dropped_level = level;
+  if (std::size(LOCAL.scratch) < length) {
+    LOCAL.scratch.resize(length);
+  }
+  return {std::data(LOCAL.scratch), length};
+}
+
+void Logger::release(size_t length, bool discard) {
+  if (LOCAL.dropped) [[unlikely]] {
+    LOCAL.dropped = false;
+    if (!discard) {
+      dropped_(LOCAL.dropped_level);
+    }
+    return;
+  }
+  if (!discard) [[likely]] {
+    (*LOCAL.producer).queue.commit(sizeof(Header) + length);
+  }
+  // note! after commit (the backend thread reads the watermark before the queues)
+  (*LOCAL.producer).reserved_at.store(0, std::memory_order_release);
+  if (LOCAL.shared) [[unlikely]] {
+    mutex_.unlock();
+  }
+  if (wait_ == Wait::BLOCK) [[unlikely]] {
+    wake();
+  }
+}
+
+Queue &Logger::get_queue() {
+  if (LOCAL.generation == generation_) [[likely]] {
+    return (*LOCAL.producer).queue;
+  }
+  std::lock_guard lock{mutex_};
+  auto count = producer_count_.load(std::memory_order_relaxed);
+  Producer *producer = nullptr;
+  // note! try to reuse the queue of a thread which has terminated
+  for (size_t i = 0; i < count; ++i) {
+    auto &tmp = *producers_[i];
+    if (tmp.released.load(std::memory_order_acquire) && tmp.queue.empty()) {
+      tmp.released.store(false, std::memory_order_relaxed);
+      producer = &tmp;
+      break;
+    }
+  }
+  auto shared = false;
+  if (producer == nullptr) {
+    if (count < (MAX_PRODUCERS - 1)) {
+      producers_[count] = std::make_unique<Producer>(queue_capacity_);
+      producer = producers_[count].get();
+      producer_count_.store(count + 1, std::memory_order_release);
+    } else {
+      // note! the last queue is shared by all threads we can't otherwise accommodate (access protected by the mutex)
+      auto &tmp = producers_[MAX_PRODUCERS - 1];
+      if (!tmp) {
+        tmp = std::make_unique<Producer>(queue_capacity_);
+        producer_count_.store(MAX_PRODUCERS, std::memory_order_release);
+      }
+      producer = tmp.get();
+      shared = true;
+    }
+  }
+  LOCAL.generation = generation_;
+  LOCAL.producer = producer;
+  LOCAL.shared = shared;
+  return (*producer).queue;
+}
+
+void Logger::run() {
+  auto thread_id = static_cast<uint32_t>(::gettid());
+  auto error = thread_options_();
+  if (!std::empty(error)) [[unlikely]] {
+    write_synthetic(Level::WARNING, now(), thread_id, fmt::format("logging: {}"sv, error));
+  }
+  size_t idle = {};
+  auto next_flush = now() + flush_freq_;
+  auto next_calibration = now() + CALIBRATION_FREQ;
+  auto next_report = now() + DROPPED_REPORT_FREQ;
+  auto next_dump = now() + metrics_freq_;
+  while (true) {
+    // note! must load before draining so we don't drop messages enqueued before stop was requested
+    auto stop = stop_.load(std::memory_order_acquire);
+    auto current = now();
+    if (current >= next_calibration) {
+      clock_.calibrate();
+      next_calibration = current + CALIBRATION_FREQ;
+    }
+    if (current >= next_report) {
+      report(current, thread_id);
+      next_report = current + DROPPED_REPORT_FREQ;
+    }
+    if (metrics_freq_.count() != 0 && current >= next_dump) {
+      dump(current, thread_id);
+      next_dump = current + metrics_freq_;
+    }
+    if (drain(stop)) {
+      idle = 0;
+      if (flush_freq_.count() != 0 && current >= next_flush) {
+        flush();
+        next_flush = current + flush_freq_;
+      }
+      continue;
+    }
+    // note! idle is a good time to flush (also when a draining thread is waiting for us)
+    auto flush_request = flush_request_.load(std::memory_order_acquire);
+    if (idle == 0 || flush_request != flushed_.load(std::memory_order_relaxed)) {
+      flush();
+      flushed_.store(flush_request, std::memory_order_release);
+    }
+    if (stop) {
+      break;
+    }
+    // note! flush is not a deadline (we always flush when becoming idle)
+    auto deadline = std::min(next_calibration, next_report);
+    if (metrics_freq_.count() != 0) {
+      deadline = std::min(deadline, next_dump);
+    }
+    wait(idle++, deadline);
+  }
+  report(now(), thread_id);
+  for (auto &output : outputs_) {
+    (*output.sink).flush();
+  }
+}
+
+// note! synthetic warning
+void Logger::report(std::chrono::nanoseconds timestamp, uint32_t thread_id) {
+  if (dropped_.empty()) [[likely]] {
+    return;
+  }
+  auto message = dropped_.take();
+  write_synthetic(Level::WARNING, timestamp, thread_id, message);
+}
+
+void Logger::dump(std::chrono::nanoseconds timestamp, uint32_t thread_id) {
+  auto message = fmt::format("*** METRICS {} ***"sv, get_stats());
+  write_synthetic(Level::INFO, timestamp, thread_id, message);
+}
+
+void Logger::write_synthetic(Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message) {
+  if (encoder_) {
+    Header header{
+        .timestamp = {},
+        .codec = nullptr,
+        .thread_id = thread_id,
+        .level = level,
+    };
+    write_binary(header, timestamp, std::as_bytes(std::span{message}));
+  } else {
+    write_text(level, timestamp, thread_id, message);
+  }
+}
+
+// note! bytes (sum of all producer queues)
+void Logger::update_queue_depth() {
+  auto count = producer_count_.load(std::memory_order_acquire);
+  uint64_t depth = {};
+  for (size_t i = 0; i < count; ++i) {
+    auto &producer = producers_[i];
+    if (producer) {
+      depth += (*producer).queue.size();
+    }
+  }
+  stats_.queue_depth.store(depth, std::memory_order_relaxed);
+  if (depth > stats_.queue_depth_max.load(std::memory_order_relaxed)) {
+    stats_.queue_depth_max.store(depth, std::memory_order_relaxed);
+  }
+}
+
+void Logger::write(Sink &sink, std::string_view const &text) {
+  if (!metrics.load(std::memory_order_relaxed)) [[likely]] {
+    sink.write(text);
+    return;
+  }
+  auto start = detail::Metrics::now();
+  sink.write(text);
+  stats_.write_count.fetch_add(1, std::memory_order_relaxed);
+  stats_.write_time.fetch_add(detail::Metrics::now() - start, std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+  auto flush_all = [&]() {
+    for (auto &output : outputs_) {
+      (*output.sink).flush();
+    }
+  };
+  if (!metrics.load(std::memory_order_relaxed)) [[likely]] {
+    flush_all();
+    return;
+  }
+  auto start = detail::Metrics::now();
+  flush_all();
+  stats_.flush_count.fetch_add(1, std::memory_order_relaxed);
+  stats_.flush_time.fetch_add(detail::Metrics::now() - start, std::memory_order_relaxed);
+}
+
+// note! spin and yield budgets are used before falling back to the wait strategy
+void Logger::wait(size_t count, std::chrono::nanoseconds deadline) {
+  if (wait_ == Wait::SPIN || count < wait_spin_count_) {
+    cpu_relax();
+    return;
+  }
+  if (wait_ == Wait::YIELD || count < (wait_spin_count_ + wait_yield_count_)) {
+    std::this_thread::yield();
+    return;
+  }
+  if (wait_ == Wait::SLEEP) {
+    std::this_thread::sleep_for(IDLE_SLEEP);
+    return;
+  }
+  block(deadline);
+}
+
+// note! must re-check after announcing, a producer may have committed before seeing the flag
+// note! bounded by the deadline (periodic tasks must still run when idle), may return early (woken, interrupted or spurious)
+void Logger::block(std::chrono::nanoseconds deadline) {
+  waiting_.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (empty() && !stop_.load(std::memory_order_relaxed) && flush_request_.load(std::memory_order_relaxed) == flushed_.load(std::memory_order_relaxed)) {
+    auto timeout = (deadline - now()).count();
+    if (timeout > 0) {
+      struct timespec relative = {
+          .tv_sec = timeout / 1000000000,
+          .tv_nsec = timeout % 1000000000,
+      };
+      futex(waiting_, FUTEX_WAIT_PRIVATE, 1, &relative);
+    }
+  }
+  waiting_.store(0, std::memory_order_relaxed);
+}
+
+void Logger::wake() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+    waiting_.store(0, std::memory_order_relaxed);
+    futex(waiting_, FUTEX_WAKE_PRIVATE, 1, nullptr);
+  }
+}
+
+bool Logger::empty() const {
+  auto count = producer_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    auto &producer = producers_[i];
+    if (producer && !(*producer).queue.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// note! k-way merge of the queue heads to maintain global timestamp order
+// note! the watermark is the oldest in-flight reservation (or now), records newer than the watermark are held back
+// reason: a producer takes its timestamp before reserving and may block (or format) while other producers commit newer records
+// note! the watermark is ignored when stopping (a producer may never commit)
+bool Logger::drain(bool stop) {
+  if (metrics.load(std::memory_order_relaxed)) [[unlikely]] {
+    update_queue_depth();
+  }
+  auto count = producer_count_.load(std::memory_order_acquire);
+  auto watermark = stop ? UINT64_MAX : clock_.now();
+  for (size_t i = 0; i < count; ++i) {
+    auto &producer = producers_[i];
+    if (!producer) {
+      continue;
+    }
+    auto reserved_at = (*producer).reserved_at.load(std::memory_order_acquire);
+    if (reserved_at != 0) {
+      watermark = std::min(watermark, reserved_at);
+    }
+  }
+  auto result = false;
+  for (size_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    Queue *next = nullptr;
+    Header const *header = nullptr;
+    std::span<std::byte const> record;
+    for (size_t j = 0; j < count; ++j) {
+      auto &producer = producers_[j];
+      if (!producer) {
+        continue;
+      }
+      auto tmp = (*producer).queue.front();
+      if (std::empty(tmp)) {
+        continue;
+      }
+      auto tmp_header = reinterpret_cast<Header const *>(std::data(tmp));
+      if (header == nullptr || (*tmp_header).timestamp < (*header).timestamp) {
+        next = &(*producer).queue;
+        header = tmp_header;
+        record = tmp;
+      }
+    }
+    if (next == nullptr || (*header).timestamp > watermark) {
+      break;
+    }
+    auto payload = record.subspan(sizeof(Header));
+    auto timestamp = clock_((*header).timestamp);
+    if (encoder_) {
+      write_binary(*header, timestamp, payload);
+    } else if ((*header).codec != nullptr) {
+      format(*header, payload);
+      write_text((*header).level, timestamp, (*header).thread_id, message_);
+    } else {
+      std::string_view message{reinterpret_cast<char const *>(std::data(payload)), std::size(payload)};
+      write_text((*header).level, timestamp, (*header).thread_id, message);
+    }
+    (*next).pop();
+    result = true;
+  }
+  return result;
+}
+
+void Logger::format(Header const &header, std::span<std::byte const> const &payload) {
+  message_.clear();
+  try {
+    (*(*header.codec).format)(payload, message_, true);
+  } catch (std::exception &e) {
+    // note! the format string can't be validated by the call-site
+    fmt::format_to(std::back_inserter(message_), R"( *** UNABLE TO FORMAT *** what="{}")"sv, e.what());
+  }
+}
+
+void Logger::write_text(Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message) {
+  buffer_.clear();
+  color_buffer_.clear();
+  for (auto &output : outputs_) {
+    if (level < output.level) {
+      continue;
+    }
+    // note! rendered once (and at most once more if any of the sinks is using color)
+    auto &buffer = output.color ? color_buffer_ : buffer_;
+    if (std::empty(buffer)) {
+      pattern_(buffer, level, timestamp, thread_id, message, output.color);
+      buffer.push_back('\n');
+    }
+    write(*output.sink, buffer);
+  }
+  // note! same as the spdlog logger
+  if (level >= Level::WARNING) {
+    flush();
+  }
+}
+
+void Logger::write_binary(Header const &header, std::chrono::nanoseconds timestamp, std::span<std::byte const> const &payload) {
+  auto encode = [&]() {
+    buffer_.clear();
+    if (header.codec != nullptr) {
+      (*encoder_)(buffer_, header.level, timestamp, header.thread_id, *header.codec, payload);
+    } else {
+      std::string_view message{reinterpret_cast<char const *>(std::data(payload)), std::size(payload)};
+      (*encoder_)(buffer_, header.level, timestamp, header.thread_id, message);
+    }
+  };
+  encode();
+  // note! a new file must be self-contained (header and call-sites)
+  auto &sink = *outputs_[0].sink;
+  if (sink.prepare(std::size(buffer_))) {
+    (*encoder_).reset();
+    encode();
+  }
+  write(sink, buffer_);
+  if (header.level >= Level::WARNING) {
+    flush();
+  }
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
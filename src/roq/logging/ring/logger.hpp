@@ -0,0 +1,157 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "roq/logging/deferred.hpp"
+#include "roq/logging/handler.hpp"
+#include "roq/logging/metadata.hpp"
+#include "roq/logging/overflow.hpp"
+#include "roq/logging/settings.hpp"
+#include "roq/logging/static_handler.hpp"
+#include "roq/logging/thread_options.hpp"
+
+#include "roq/logging/binary/encoder.hpp"
+
+#include "roq/logging/ring/clock.hpp"
+#include "roq/logging/ring/pattern.hpp"
+#include "roq/logging/ring/queue.hpp"
+#include "roq/logging/ring/sink.hpp"
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// lock-free asynchronous logger
+// - each producer thread owns a single-producer single-consumer queue
+// - a single backend thread drains all queues in timestamp order and writes to the sink
+// - records newer than the oldest in-flight reservation (blocked or still formatting) are held back by the backend thread
+// - the backend thread uses a configurable wait strategy when idle (sleep, spin, yield or block)
+// - producers block (default) or drop when their queue is full, dropped messages are reported by the backend thread
+// - the backend thread collects queue depth and write/flush time when metrics are enabled (and may periodically dump all metrics)
+// - a terminating thread may drain (wait for the backend thread to empty all queues and flush the sink)
+// - each message is formatted once and then written to all sinks matching its level (the primary sink and any additional sinks)
+
+struct Logger final : public Handler {
+  Logger(Settings const &, Metadata const &);
+
+  ~Logger() override;
+
+  friend struct logging::StaticHandler;  // note! direct calls (ROQ_LOGGING_STATIC_HANDLER)
+
+ protected:
+  struct Header final {
+    uint64_t timestamp;  // note! clock ticks
+    Codec const *codec;  // note! nullptr means the payload is text
+    uint32_t thread_id;
+    Level level;
+  };
+
+  void operator()(Level, std::string_view const &message) override;
+
+  std::span<char> reserve(Level) override;
+  void commit(Level, size_t length) override;
+
+  std::span<std::byte> reserve_deferred(Level, Codec const &, size_t length) override;
+
+  Stats get_stats() const override;
+
+  bool drain(std::chrono::nanoseconds timeout, bool signal) override;
+
+  std::span<std::byte> acquire(Queue &, Level, size_t length, Codec const * = nullptr);
+  void release(size_t length, bool discard = false);
+  std::span<std::byte> drop(Level, size_t length);
+
+  Queue &get_queue();
+
+  void run();
+  bool drain(bool stop);
+  void wait(size_t count, std::chrono::nanoseconds deadline);
+  void block(std::chrono::nanoseconds deadline);
+  void wake();
+  bool empty() const;
+  void report(std::chrono::nanoseconds timestamp, uint32_t thread_id);
+  void dump(std::chrono::nanoseconds timestamp, uint32_t thread_id);
+  void write_synthetic(Level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message);
+  void update_queue_depth();
+  void write(Sink &, std::string_view const &text);
+  void flush();
+  void format(Header const &, std::span<std::byte const> const &payload);
+  void write_text(Level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message);
+  void write_binary(Header const &, std::chrono::nanoseconds timestamp, std::span<std::byte const> const &payload);
+
+ public:
+  static constexpr size_t const MAX_PRODUCERS = 256;
+
+  enum class Wait {
+    SLEEP,
+    SPIN,
+    YIELD,
+    BLOCK,  // note! futex, producers must wake the backend thread
+  };
+
+  struct Producer final {
+    explicit Producer(size_t capacity) : queue{capacity} {}
+
+    Queue queue;
+    uint32_t thread_id = {};
+    std::atomic<bool> released = {};
+    alignas(Queue::CACHE_LINE_SIZE) std::atomic<uint64_t> reserved_at = {};  // note! timestamp of the in-flight reservation (0 means none)
+  };
+
+  struct Output final {
+    std::unique_ptr<Sink> sink;
+    Level level = {};  // note! minimum
+    bool color = {};
+  };
+
+ private:
+  uint64_t const generation_;
+  std::chrono::nanoseconds const flush_freq_;
+  Clock clock_;  // note! calibrated by the backend thread
+  std::vector<Output> const outputs_;  // note! primary sink first
+  std::unique_ptr<binary::Encoder> const encoder_;  // note! binary format (only the primary sink)
+  bool const deferred_;
+  ThreadOptions const thread_options_;
+  Wait const wait_;
+  uint32_t const wait_spin_count_;
+  uint32_t const wait_yield_count_;
+  size_t const queue_capacity_;
+  Overflow const overflow_;
+  Dropped dropped_;
+  std::chrono::nanoseconds const metrics_freq_;
+  // note! updated by the backend thread (only when metrics are enabled)
+  struct {
+    std::atomic<uint64_t> queue_depth;
+    std::atomic<uint64_t> queue_depth_max;
+    std::atomic<uint64_t> write_count;
+    std::atomic<uint64_t> write_time;
+    std::atomic<uint64_t> flush_count;
+    std::atomic<uint64_t> flush_time;
+  } stats_ = {};
+  std::mutex mutex_;  // note! only used when registering producers and when accessing the shared queue
+  std::array<std::unique_ptr<Producer>, MAX_PRODUCERS> producers_;
+  std::atomic<size_t> producer_count_ = {};
+  std::atomic<bool> stop_ = {};
+  std::atomic<uint32_t> waiting_ = {};  // note! only used by the block wait strategy
+  std::atomic<uint64_t> flush_request_ = {};  // note! incremented by a draining thread
+  std::atomic<uint64_t> flushed_ = {};        // note! last flush request completed by the backend thread
+  // note! backend thread only
+  std::string buffer_;
+  std::string color_buffer_;
+  std::string message_;
+  Pattern pattern_;
+  std::thread thread_;  // note! last (must be started after all other members have been initialized)
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,239 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/mapped_file.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/binary/decoder.hpp"
+
+#include "roq/logging/ring/files.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === CONSTANTS ===
+
+namespace {
+auto const WINDOW_SIZE = 16uz * 1024 * 1024;      // note! must be a multiple of the page size
+auto const ALLOCATION_SIZE = 64uz * 1024 * 1024;  // note! used when there is no max size
+auto const SCAN_SIZE = 64uz * 1024;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! a text file that wasn't closed (e.g. crash) still has the preallocated (zero-filled) tail
+uint64_t find_end_text(int fd, uint64_t size) {
+  std::array<char, SCAN_SIZE> buffer;
+  while (size > 0) {
+    auto length = std::min<uint64_t>(size, std::size(buffer));
+    auto offset = size - length;
+    auto result = ::pread(fd, std::data(buffer), length, static_cast<off_t>(offset));
+    if (result != static_cast<ssize_t>(length)) {
+      return size;  // note! can't tell, keep everything
+    }
+    for (auto i = length; i > 0; --i) {
+      if (buffer[i - 1] != '\0') {
+        return offset + i;
+      }
+    }
+    size = offset;
+  }
+  return 0;
+}
+
+// note! binary frames may end with zero bytes, the end can only be found by decoding frame by frame
+// note! an incomplete or corrupt frame (e.g. crash while writing) is dropped together with everything after it
+uint64_t find_end_binary(int fd, uint64_t size) {
+  struct Handler final : public binary::Decoder::Handler {
+    void operator()(std::vector<std::pair<std::string, std::string>> const &) override {}
+    void operator()(std::string_view const &) override {}
+  } handler;
+  binary::Decoder decoder{handler};
+  std::string buffer;
+  std::array<char, SCAN_SIZE> chunk;
+  uint64_t offset = {};
+  try {
+    while (offset < size && !decoder.end()) {
+      auto length = std::min<uint64_t>(size - offset, std::size(chunk));
+      auto result = ::pread(fd, std::data(chunk), length, static_cast<off_t>(offset));
+      if (result != static_cast<ssize_t>(length)) {
+        return size;  // note! can't tell, keep everything
+      }
+      offset += length;
+      buffer.append(std::data(chunk), length);
+      buffer.erase(0, decoder(buffer));
+    }
+  } catch (std::exception &) {
+    // note! corrupt, keep what could be decoded
+  }
+  return decoder.get_length();
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+MappedFile::MappedFile(Settings const &settings)
+    : path_{settings.log.path}, max_size_{settings.log.max_size}, max_files_{settings.log.max_files}, binary_{settings.log.format == "binary"sv},
+      archiver_{Archiver::create(settings)} {
+  static_assert((WINDOW_SIZE % 4096) == 0);
+  auto error = open(false);
+  if (error != 0) {
+    close();
+    throw RuntimeError{R"(Unable to open log file: path="{}", error="{}")"sv, path_, std::strerror(error)};
+  }
+  if (settings.log.rotate_on_open && size_ > 0) {
+    rotate();
+  }
+}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+// note! an empty file is never rotated (a message larger than max size would otherwise push history out)
+bool MappedFile::prepare(size_t length) {
+  if (fd_ < 0) [[unlikely]] {
+    return reopen();  // note! the previous attempt failed
+  }
+  if (max_size_ == 0 || size_ == 0 || (size_ + length) <= max_size_) {
+    return false;
+  }
+  rotate();
+  return true;
+}
+
+void MappedFile::write(std::string_view const &text) {
+  prepare(std::size(text));
+  if (fd_ < 0) [[unlikely]] {
+    return;  // note! nowhere to report (the text is dropped)
+  }
+  auto remaining = std::as_bytes(std::span{text});
+  while (!std::empty(remaining)) {
+    if (size_ >= allocated_) [[unlikely]] {
+      if (allocate(size_ + std::max(std::size(remaining), ALLOCATION_SIZE)) != 0) {
+        return;  // note! nowhere to report (e.g. disk full)
+      }
+    }
+    if (window_ == nullptr || size_ >= (window_offset_ + window_size_)) [[unlikely]] {
+      if (map(size_) != 0) {
+        return;  // note! nowhere to report
+      }
+    }
+    auto offset = size_ - window_offset_;
+    auto length = std::min<uint64_t>({std::size(remaining), window_size_ - offset, allocated_ - size_});
+    std::memcpy(window_ + offset, std::data(remaining), length);
+    remaining = remaining.subspan(length);
+    size_ += length;
+  }
+}
+
+// note! the kernel owns the dirty pages (we only hint that writeback may start)
+void MappedFile::flush() {
+  if (window_ != nullptr) {
+    ::msync(window_, window_size_, MS_ASYNC);
+  }
+}
+
+// note! returns errno
+int MappedFile::open(bool truncate) {
+  auto flags = O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+  fd_ = ::open(path_.c_str(), flags, 0644);
+  if (fd_ < 0) {
+    return errno;
+  }
+  struct stat buffer = {};
+  auto size = ::fstat(fd_, &buffer) == 0 ? static_cast<uint64_t>(buffer.st_size) : 0;
+  size_ = binary_ ? find_end_binary(fd_, size) : find_end_text(fd_, size);
+  if (size_ < size && ::ftruncate(fd_, static_cast<off_t>(size_)) < 0) {
+    return errno;
+  }
+  allocated_ = size_;
+  return allocate(max_size_ != 0 ? std::max(max_size_, size_) : (size_ + ALLOCATION_SIZE));
+}
+
+void MappedFile::close() {
+  if (fd_ < 0) {
+    return;
+  }
+  unmap();
+  // note! release the preallocated tail
+  [[maybe_unused]] auto result = ::ftruncate(fd_, static_cast<off_t>(size_));
+  ::close(fd_);
+  fd_ = -1;
+  allocated_ = 0;
+}
+
+void MappedFile::rotate() {
+  close();
+  if (archiver_) {
+    (*archiver_)();
+  } else {
+    rotate_files(path_, max_files_);
+  }
+  // note! called from the backend thread, a failure (e.g. disk full) drops text until the file can be opened
+  reopen();
+}
+
+bool MappedFile::reopen() {
+  if (open(true) != 0) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// note! returns errno
+int MappedFile::allocate(uint64_t size) {
+  if (size <= allocated_) {
+    return 0;
+  }
+  auto result = ::posix_fallocate(fd_, static_cast<off_t>(allocated_), static_cast<off_t>(size - allocated_));
+  if (result == 0) {
+    allocated_ = size;
+  }
+  return result;
+}
+
+// note! returns errno
+int MappedFile::map(uint64_t offset) {
+  unmap();
+  window_offset_ = offset & ~static_cast<uint64_t>(WINDOW_SIZE - 1);
+  window_size_ = WINDOW_SIZE;
+  // note! pre-fault the window so page-cache allocation happens here (and not while copying)
+  auto result = ::mmap(nullptr, window_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, static_cast<off_t>(window_offset_));
+  if (result == MAP_FAILED) {
+    return errno;
+  }
+  window_ = static_cast<std::byte *>(result);
+  return 0;
+}
+
+void MappedFile::unmap() {
+  if (window_ != nullptr) {
+    ::munmap(window_, window_size_);
+    window_ = nullptr;
+  }
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
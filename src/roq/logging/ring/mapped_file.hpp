@@ -0,0 +1,63 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "roq/logging/settings.hpp"
+
+#include "roq/logging/ring/archiver.hpp"
+#include "roq/logging/ring/sink.hpp"
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// memory-mapped file
+// - each file is preallocated (fallocate) and written through a sliding (pre-faulted) memory-mapped window
+// - the file is truncated to the real length when rotating or closing
+// - no write system calls (and no page-cache allocation while the file grows)
+// note! readers will see the preallocated (zero-filled) tail until the file has been closed
+// note! reopening an existing file finds the end by decoding (binary) or by skipping the zero-filled tail (text)
+struct MappedFile final : public Sink {
+  explicit MappedFile(Settings const &);
+
+  ~MappedFile() override;
+
+  bool terminal() const override { return false; }
+
+  bool prepare(size_t length) override;
+
+  void write(std::string_view const &text) override;
+  void flush() override;
+
+ protected:
+  int open(bool truncate);
+  void close();
+  void rotate();
+  bool reopen();
+
+  int allocate(uint64_t size);
+  int map(uint64_t offset);
+  void unmap();
+
+ private:
+  std::string const path_;
+  uint64_t const max_size_;
+  size_t const max_files_;
+  bool const binary_;  // note! the end of a binary file can't be found by scanning for zero bytes
+  int fd_ = -1;
+  uint64_t size_ = {};       // note! bytes written
+  uint64_t allocated_ = {};  // note! bytes preallocated
+  std::byte *window_ = nullptr;
+  uint64_t window_offset_ = {};
+  size_t window_size_ = {};
+  std::unique_ptr<Archiver> archiver_;
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
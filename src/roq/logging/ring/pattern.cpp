@@ -0,0 +1,318 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/pattern.hpp"
+
+#include <unistd.h>
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+
+#include "roq/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === CONSTANTS ===
+
+namespace {
+auto const RESET_COLOR = "\e[0m"sv;
+auto const MAX_DATE_TIME_LENGTH = 256uz;
+
+// note! "00" to "99"
+constexpr auto const DIGITS = []() {
+  std::array<char, 200> result = {};
+  for (size_t i = 0; i < 100; ++i) {
+    result[i * 2] = static_cast<char>('0' + (i / 10));
+    result[i * 2 + 1] = static_cast<char>('0' + (i % 10));
+  }
+  return result;
+}();
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! matching the colors used by the spdlog logger
+constexpr auto get_color(Level level) {
+  switch (level) {
+    using enum Level;
+    case DEBUG:
+      return "\e[1;94m"sv;  // blue
+    case INFO:
+      return "\e[0;37m"sv;  // grey
+    case WARNING:
+      return "\e[1;92m"sv;  // green
+    case ERROR:
+    case CRITICAL:
+      return "\e[0;101m"sv;  // red background
+  }
+  return std::string_view{};
+}
+
+// note! matching spdlog's short level names
+constexpr auto get_level_short(Level level) {
+  switch (level) {
+    using enum Level;
+    case DEBUG:
+      return "D"sv;
+    case INFO:
+      return "I"sv;
+    case WARNING:
+      return "W"sv;
+    case ERROR:
+      return "E"sv;
+    case CRITICAL:
+      return "C"sv;
+  }
+  return "?"sv;
+}
+
+// note! matching spdlog's long level names
+constexpr auto get_level_long(Level level) {
+  switch (level) {
+    using enum Level;
+    case DEBUG:
+      return "debug"sv;
+    case INFO:
+      return "info"sv;
+    case WARNING:
+      return "warning"sv;
+    case ERROR:
+      return "error"sv;
+    case CRITICAL:
+      return "critical"sv;
+  }
+  return "?"sv;
+}
+
+// note! translates to strftime (empty if not a date/time flag)
+constexpr auto get_date_time_format(char flag) {
+  switch (flag) {
+    case 'Y':
+      return "%Y"sv;
+    case 'y':
+      return "%y"sv;
+    case 'm':
+      return "%m"sv;
+    case 'd':
+      return "%d"sv;
+    case 'H':
+      return "%H"sv;
+    case 'M':
+      return "%M"sv;
+    case 'S':
+      return "%S"sv;
+    case 'T':
+      return "%H:%M:%S"sv;
+    case 'D':
+      return "%m/%d/%y"sv;
+    case 'b':
+      return "%b"sv;
+    case 'a':
+      return "%a"sv;
+    case 'E':
+      return "%s"sv;
+    case 'z':
+      return "%z"sv;
+  }
+  return std::string_view{};
+}
+
+void write_2(char *out, uint32_t value) {
+  std::memcpy(out, &DIGITS[value * 2], 2);
+}
+
+template <size_t N>
+void append_integer(std::string &buffer, auto value) {
+  std::array<char, N> tmp;
+  auto result = std::to_chars(std::data(tmp), std::data(tmp) + std::size(tmp), value);
+  buffer.append(std::data(tmp), result.ptr);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Pattern::Pattern(std::string_view const &pattern) {
+  compile(pattern);
+}
+
+void Pattern::operator()(
+    std::string &buffer, Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message, bool color) {
+  auto seconds = std::chrono::floor<std::chrono::seconds>(timestamp);
+  if (seconds != last_second_) [[unlikely]] {
+    update(seconds);
+  }
+  auto nanos = static_cast<uint32_t>((timestamp - seconds).count());
+  for (auto &emitter : emitters_) {
+    switch (emitter.type) {
+      using enum Type;
+      case TEXT:
+        buffer.append(texts_[emitter.index]);
+        break;
+      case DATE_TIME:
+        buffer.append(date_times_[emitter.index].cache);
+        break;
+      case MILLISECONDS: {
+        auto value = nanos / 1000000;
+        std::array<char, 3> tmp;
+        tmp[0] = static_cast<char>('0' + value / 100);
+        write_2(&tmp[1], value % 100);
+        buffer.append(std::data(tmp), std::size(tmp));
+        break;
+      }
+      case MICROSECONDS: {
+        auto value = nanos / 1000;
+        std::array<char, 6> tmp;
+        write_2(&tmp[0], value / 10000);
+        write_2(&tmp[2], (value / 100) % 100);
+        write_2(&tmp[4], value % 100);
+        buffer.append(std::data(tmp), std::size(tmp));
+        break;
+      }
+      case NANOSECONDS: {
+        std::array<char, 9> tmp;
+        tmp[0] = static_cast<char>('0' + nanos / 100000000);
+        auto value = nanos % 100000000;
+        write_2(&tmp[1], value / 1000000);
+        write_2(&tmp[3], (value / 10000) % 100);
+        write_2(&tmp[5], (value / 100) % 100);
+        write_2(&tmp[7], value % 100);
+        buffer.append(std::data(tmp), std::size(tmp));
+        break;
+      }
+      case THREAD_ID:
+        append_integer<10>(buffer, thread_id);
+        break;
+      case PROCESS_ID:
+        buffer.append(process_id_);
+        break;
+      case LEVEL_SHORT:
+        buffer.append(get_level_short(level));
+        break;
+      case LEVEL_LONG:
+        buffer.append(get_level_long(level));
+        break;
+      case MESSAGE:
+        buffer.append(message);
+        break;
+      case COLOR_START:
+        if (color) {
+          buffer.append(get_color(level));
+        }
+        break;
+      case COLOR_END:
+        if (color) {
+          buffer.append(RESET_COLOR);
+        }
+        break;
+    }
+  }
+}
+
+// note! literal text is merged into the surrounding date/time (rendered once per second)
+void Pattern::compile(std::string_view const &pattern) {
+  std::string text;       // note! literal
+  std::string date_time;  // note! strftime (literal text escaped)
+  auto has_date_time = false;
+  auto flush = [&]() {
+    if (has_date_time) {
+      emitters_.push_back({.type = Type::DATE_TIME, .index = static_cast<uint32_t>(std::size(date_times_))});
+      date_times_.push_back({.format = date_time, .cache = {}});
+    } else if (!std::empty(text)) {
+      emitters_.push_back({.type = Type::TEXT, .index = static_cast<uint32_t>(std::size(texts_))});
+      texts_.emplace_back(text);
+    }
+    text.clear();
+    date_time.clear();
+    has_date_time = false;
+  };
+  auto append = [&](char c) {
+    text.push_back(c);
+    if (c == '%') {
+      date_time.append("%%"sv);
+    } else {
+      date_time.push_back(c);
+    }
+  };
+  auto add = [&](Type type) {
+    flush();
+    emitters_.push_back({.type = type, .index = {}});
+  };
+  for (size_t i = 0; i < std::size(pattern); ++i) {
+    auto c = pattern[i];
+    if (c != '%') {
+      append(c);
+      continue;
+    }
+    if (++i == std::size(pattern)) {
+      throw RuntimeError{R"(Invalid log pattern (ends with '%'): "{}")"sv, pattern};
+    }
+    auto flag = pattern[i];
+    auto format = get_date_time_format(flag);
+    if (!std::empty(format)) {
+      date_time.append(format);
+      has_date_time = true;
+      continue;
+    }
+    switch (flag) {
+      case '%':
+        append('%');
+        break;
+      case 'v':
+        add(Type::MESSAGE);
+        break;
+      case 't':
+        add(Type::THREAD_ID);
+        break;
+      case 'P':
+        add(Type::PROCESS_ID);
+        break;
+      case 'L':
+        add(Type::LEVEL_SHORT);
+        break;
+      case 'l':
+        add(Type::LEVEL_LONG);
+        break;
+      case '^':
+        add(Type::COLOR_START);
+        break;
+      case '$':
+        add(Type::COLOR_END);
+        break;
+      case 'e':
+        add(Type::MILLISECONDS);
+        break;
+      case 'f':
+        add(Type::MICROSECONDS);
+        break;
+      case 'F':
+        add(Type::NANOSECONDS);
+        break;
+      default:
+        throw RuntimeError{R"(Invalid log pattern (unknown flag '%{}'): "{}")"sv, flag, pattern};
+    }
+  }
+  flush();
+  append_integer<10>(process_id_, ::getpid());
+}
+
+void Pattern::update(std::chrono::seconds seconds) {
+  auto time = static_cast<std::time_t>(seconds.count());
+  struct tm tm = {};
+  ::localtime_r(&time, &tm);
+  std::array<char, MAX_DATE_TIME_LENGTH> tmp;
+  for (auto &item : date_times_) {
+    auto length = std::strftime(std::data(tmp), std::size(tmp), item.format.c_str(), &tm);
+    item.cache.assign(std::data(tmp), length);
+  }
+  last_second_ = seconds;
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
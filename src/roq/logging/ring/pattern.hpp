@@ -0,0 +1,77 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "roq/logging/level.hpp"
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// log pattern (spdlog compatible subset)
+// - compiled once into a fixed list of emitters
+// - date/time flags (and the literal text between them) are rendered once per second and then copied
+// - fraction digits are written using a two-digit lookup table (fixed width, no branches)
+// - supported flags:
+//   %v message, %t thread id, %P process id, %L level (short), %l level (long), %^ start color, %$ end color, %% percent
+//   %Y year, %y year (2 digits), %m month, %d day, %H hour, %M minute, %S second, %T (%H:%M:%S), %D (%m/%d/%y),
+//   %b month (abbreviated), %a weekday (abbreviated), %E seconds since epoch, %z timezone offset
+//   %e milliseconds, %f microseconds, %F nanoseconds
+// note! throws on unknown flags
+
+struct Pattern final {
+  static constexpr std::string_view const DEFAULT = "%L%m%d %T.%F %t %^%v%$";  // note! glog style (with nanoseconds)
+
+  explicit Pattern(std::string_view const &pattern);
+
+  Pattern(Pattern const &) = delete;
+
+  // note! appends to buffer (color is only applied when enabled)
+  void operator()(std::string &buffer, Level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message, bool color);
+
+ protected:
+  enum class Type : uint8_t {
+    TEXT,
+    DATE_TIME,
+    MILLISECONDS,
+    MICROSECONDS,
+    NANOSECONDS,
+    THREAD_ID,
+    PROCESS_ID,
+    LEVEL_SHORT,
+    LEVEL_LONG,
+    MESSAGE,
+    COLOR_START,
+    COLOR_END,
+  };
+
+  struct Emitter final {
+    Type type = {};
+    uint32_t index = {};  // note! TEXT (texts_) or DATE_TIME (date_times_)
+  };
+
+  struct DateTime final {
+    std::string format;  // note! strftime
+    std::string cache;
+  };
+
+  void compile(std::string_view const &pattern);
+  void update(std::chrono::seconds);
+
+ private:
+  std::vector<Emitter> emitters_;
+  std::vector<std::string> texts_;
+  std::vector<DateTime> date_times_;
+  std::string process_id_;
+  std::chrono::seconds last_second_ = std::chrono::seconds::min();
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
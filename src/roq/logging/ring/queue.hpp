@@ -0,0 +1,148 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// single-producer single-consumer queue of variable length records
+// - each record is prefixed by its length and aligned to 8 bytes
+// - records are always contiguous (a padding marker is inserted when wrapping)
+// - producer and consumer keep a cached copy of the opposite index to avoid cache-line ping-pong
+
+struct Queue final {
+  static constexpr size_t const ALIGNMENT = 8;
+  static constexpr size_t const CACHE_LINE_SIZE = 64;
+
+  explicit Queue(size_t capacity)
+      : capacity_{std::bit_ceil(capacity)}, mask_{capacity_ - 1},
+        buffer_{new (std::align_val_t{CACHE_LINE_SIZE}) std::byte[capacity_], Deleter{}} {
+    assert(capacity_ >= (CACHE_LINE_SIZE * 2));
+  }
+
+  Queue(Queue const &) = delete;
+
+  size_t capacity() const { return capacity_; }
+
+  // note! the largest record we can ever accept (guarantees progress when wrapping)
+  size_t max_length() const { return (capacity_ / 2) - sizeof(Prefix); }
+
+  // producer
+
+  // returns a contiguous region for the payload, or empty if the queue is full
+  std::span<std::byte> try_reserve(size_t length) {
+    assert(length <= max_length());
+    auto total = align(sizeof(Prefix) + length);
+    auto offset = producer_.write & mask_;
+    auto contiguous = capacity_ - offset;
+    auto padding = contiguous < total ? contiguous : size_t{0};
+    auto required = producer_.write + padding + total;
+    if ((required - producer_.read_cache) > capacity_) [[unlikely]] {
+      producer_.read_cache = read_.load(std::memory_order_acquire);
+      if ((required - producer_.read_cache) > capacity_) {
+        return {};
+      }
+    }
+    producer_.padding = padding;
+    if (padding != 0) {
+      offset = 0;
+    }
+    return {&buffer_[offset + sizeof(Prefix)], length};
+  }
+
+  // note! length must not exceed what was reserved
+  void commit(size_t length) {
+    if (producer_.padding != 0) {
+      auto &padding = *reinterpret_cast<Prefix *>(&buffer_[producer_.write & mask_]);
+      padding.length = PADDING;
+      producer_.write += producer_.padding;
+      producer_.padding = 0;
+    }
+    auto &prefix = *reinterpret_cast<Prefix *>(&buffer_[producer_.write & mask_]);
+    prefix.length = static_cast<uint32_t>(length);
+    producer_.write += align(sizeof(Prefix) + length);
+    write_.store(producer_.write, std::memory_order_release);
+  }
+
+  // consumer
+
+  // returns the next record, or empty if the queue is empty
+  std::span<std::byte const> front() {
+    while (true) {
+      if (consumer_.read == consumer_.write_cache) {
+        consumer_.write_cache = write_.load(std::memory_order_acquire);
+        if (consumer_.read == consumer_.write_cache) {
+          return {};
+        }
+      }
+      auto offset = consumer_.read & mask_;
+      auto &prefix = *reinterpret_cast<Prefix const *>(&buffer_[offset]);
+      if (prefix.length != PADDING) [[likely]] {
+        return {&buffer_[offset + sizeof(Prefix)], prefix.length};
+      }
+      consumer_.read += capacity_ - offset;
+    }
+  }
+
+  // note! must follow a successful front()
+  void pop() {
+    auto &prefix = *reinterpret_cast<Prefix const *>(&buffer_[consumer_.read & mask_]);
+    consumer_.read += align(sizeof(Prefix) + prefix.length);
+    read_.store(consumer_.read, std::memory_order_release);
+  }
+
+  // note! approximate, may be called from any thread
+  size_t size() const {
+    auto read = read_.load(std::memory_order_relaxed);
+    auto write = write_.load(std::memory_order_relaxed);
+    return write >= read ? (write - read) : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+ protected:
+  static constexpr size_t align(size_t size) { return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+ private:
+  struct Prefix final {
+    uint32_t length;
+    uint32_t reserved;
+  };
+  static_assert(sizeof(Prefix) == ALIGNMENT);
+
+  static constexpr uint32_t const PADDING = ~uint32_t{};
+
+  struct Deleter final {
+    void operator()(std::byte *ptr) const { ::operator delete[](ptr, std::align_val_t{CACHE_LINE_SIZE}); }
+  };
+
+  size_t const capacity_;
+  size_t const mask_;
+  std::unique_ptr<std::byte[], Deleter> const buffer_;
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> write_ = {};
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> read_ = {};
+  alignas(CACHE_LINE_SIZE) struct {
+    uint64_t write = {};
+    uint64_t read_cache = {};
+    size_t padding = {};
+  } producer_;
+  alignas(CACHE_LINE_SIZE) struct {
+    uint64_t read = {};
+    uint64_t write_cache = {};
+  } consumer_;
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
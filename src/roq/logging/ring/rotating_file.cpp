@@ -0,0 +1,160 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/rotating_file.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/ring/files.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === CONSTANTS ===
+
+namespace {
+auto const BUFFER_SIZE = 65536uz;
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+RotatingFile::RotatingFile(Settings const &settings)
+    : path_{settings.log.path}, max_size_{settings.log.max_size}, max_files_{settings.log.max_files}, archiver_{Archiver::create(settings)} {
+  if (Compressor::is_enabled(settings.log.compression)) {
+    compressor_ = std::make_unique<Compressor>(settings.log.compression_level);
+  }
+  buffer_.reserve(BUFFER_SIZE);
+  auto error = open(false);
+  if (error != 0) {
+    throw RuntimeError{R"(Unable to open log file: path="{}", error="{}")"sv, path_, std::strerror(error)};
+  }
+  // note! a live compressed file is never appended to (it may end with an unterminated frame, e.g. crash)
+  if ((settings.log.rotate_on_open || compressor_) && size_ > 0) {
+    rotate();
+  }
+}
+
+RotatingFile::~RotatingFile() {
+  flush();
+  close();
+}
+
+// note! an empty file is never rotated (a message larger than max size would otherwise push history out)
+bool RotatingFile::prepare(size_t length) {
+  if (fd_ < 0) [[unlikely]] {
+    return open(true) == 0;  // note! the previous attempt failed
+  }
+  auto size = length_ + std::size(buffer_);
+  if (max_size_ == 0 || size == 0 || (size + length) <= max_size_) {
+    return false;
+  }
+  flush();
+  rotate();
+  return true;
+}
+
+void RotatingFile::write(std::string_view const &text) {
+  prepare(std::size(text));
+  if ((std::size(buffer_) + std::size(text)) > BUFFER_SIZE) {
+    flush();
+  }
+  buffer_.append(text);
+}
+
+void RotatingFile::flush() {
+  if (std::empty(buffer_)) {
+    return;
+  }
+  if (fd_ < 0) [[unlikely]] {
+    buffer_.clear();  // note! nowhere to report (the text is dropped)
+    return;
+  }
+  if (compressor_) {
+    compressed_.clear();
+    try {
+      (*compressor_)(buffer_, compressed_, Compressor::Mode::FLUSH);
+    } catch (...) {
+      // note! nowhere to report
+    }
+    append(compressed_);
+    frame_ = true;
+    length_ += std::size(buffer_);
+  } else {
+    append(buffer_);
+    length_ = size_;
+  }
+  buffer_.clear();
+}
+
+void RotatingFile::append(std::string_view const &buffer) {
+  auto remaining = buffer;
+  while (!std::empty(remaining)) {
+    auto result = ::write(fd_, std::data(remaining), std::size(remaining));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;  // note! nowhere to report
+    }
+    remaining.remove_prefix(result);
+    size_ += result;
+  }
+}
+
+// note! returns errno
+int RotatingFile::open(bool truncate) {
+  auto flags = O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND);
+  fd_ = ::open(path_.c_str(), flags, 0644);
+  if (fd_ < 0) {
+    size_ = {};
+    length_ = {};
+    return errno;
+  }
+  struct stat buffer = {};
+  size_ = ::fstat(fd_, &buffer) == 0 ? static_cast<size_t>(buffer.st_size) : 0;
+  length_ = size_;  // note! an existing compressed file is always rotated (see constructor)
+  return 0;
+}
+
+void RotatingFile::close() {
+  if (frame_) {
+    compressed_.clear();
+    try {
+      (*compressor_)({}, compressed_, Compressor::Mode::END);
+    } catch (...) {
+      // note! nowhere to report
+    }
+    append(compressed_);
+    frame_ = false;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+void RotatingFile::rotate() {
+  close();
+  if (archiver_) {
+    (*archiver_)();
+  } else {
+    rotate_files(path_, max_files_);
+  }
+  // note! called from the backend thread, a failure (e.g. too many open files) drops text until the file can be opened
+  open(true);
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,56 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "roq/logging/settings.hpp"
+
+#include "roq/logging/ring/archiver.hpp"
+#include "roq/logging/ring/compressor.hpp"
+#include "roq/logging/ring/sink.hpp"
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// note! same naming convention as spdlog: "path/name.ext" --> "path/name.1.ext", "path/name.2.ext", etc.
+// note! with streaming compression, the file is a sequence of zstd frames (max size applies to the uncompressed text)
+// note! with streaming compression, an existing file is rotated when opened (never appended to)
+struct RotatingFile final : public Sink {
+  explicit RotatingFile(Settings const &);
+
+  ~RotatingFile() override;
+
+  bool terminal() const override { return false; }
+
+  bool prepare(size_t length) override;
+
+  void write(std::string_view const &text) override;
+  void flush() override;
+
+ protected:
+  int open(bool truncate);
+  void close();
+  void rotate();
+
+  void append(std::string_view const &buffer);
+
+ private:
+  std::string const path_;
+  size_t const max_size_;
+  size_t const max_files_;
+  int fd_ = -1;
+  size_t size_ = {};    // note! bytes written to the file
+  size_t length_ = {};  // note! text written to the file (before compression), used when deciding to rotate
+  std::string buffer_;
+  std::unique_ptr<Compressor> compressor_;
+  std::string compressed_;
+  bool frame_ = {};  // note! an incomplete frame has been written
+  std::unique_ptr<Archiver> archiver_;
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,26 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <string_view>
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// note! only ever accessed from the backend thread
+struct Sink {
+  virtual ~Sink() = default;
+
+  virtual bool terminal() const = 0;
+
+  // note! returns true if a new file was started (before writing length bytes)
+  virtual bool prepare(size_t length) = 0;
+
+  virtual void write(std::string_view const &text) = 0;
+  virtual void flush() = 0;
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
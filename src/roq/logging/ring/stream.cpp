@@ -0,0 +1,55 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/ring/stream.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// === CONSTANTS ===
+
+namespace {
+auto const BUFFER_SIZE = 65536uz;
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Stream::Stream(int fd) : fd_{fd}, terminal_{::isatty(fd) != 0} {
+  buffer_.reserve(BUFFER_SIZE);
+}
+
+Stream::~Stream() {
+  flush();
+}
+
+void Stream::write(std::string_view const &text) {
+  if ((std::size(buffer_) + std::size(text)) > BUFFER_SIZE) {
+    flush();
+  }
+  buffer_.append(text);
+}
+
+void Stream::flush() {
+  std::string_view remaining{buffer_};
+  while (!std::empty(remaining)) {
+    auto result = ::write(fd_, std::data(remaining), std::size(remaining));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;  // note! nowhere to report
+    }
+    remaining.remove_prefix(result);
+  }
+  buffer_.clear();
+}
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
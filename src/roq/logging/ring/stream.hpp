@@ -0,0 +1,34 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <string>
+
+#include "roq/logging/ring/sink.hpp"
+
+namespace roq {
+namespace logging {
+namespace ring {
+
+// file descriptor owned by someone else, e.g. stdout
+struct Stream final : public Sink {
+  explicit Stream(int fd);
+
+  ~Stream() override;
+
+  bool terminal() const override { return terminal_; }
+
+  bool prepare(size_t) override { return false; }
+
+  void write(std::string_view const &text) override;
+  void flush() override;
+
+ private:
+  int const fd_;
+  bool const terminal_;
+  std::string buffer_;
+};
+
+}  // namespace ring
+}  // namespace logging
+}  // namespace roq
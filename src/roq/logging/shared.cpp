@@ -9,8 +9,10 @@ namespace logging {
 
 thread_local std::string message_buffer;
 
-size_t verbosity = 0;
+std::atomic<size_t> verbosity = 0;
 bool terminal_color = true;
+std::atomic<bool> metrics = false;
+std::chrono::nanoseconds drain_timeout = std::chrono::seconds{1};
 
 }  // namespace logging
 }  // namespace roq
@@ -0,0 +1,103 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/shm/logger.hpp"
+
+#include <unistd.h>
+
+#include <ctime>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/shared.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+namespace roq {
+namespace logging {
+namespace shm {
+
+// === CONSTANTS ===
+
+namespace {
+auto const CAPACITY = 1048576uz;
+auto const BLOCK_SLEEP = 10us;
+auto const DRAIN_SLEEP = 1ms;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+thread_local uint32_t const THREAD_ID = static_cast<uint32_t>(::gettid());
+
+auto create_segment(auto &settings) {
+  if (std::empty(settings.log.shm_name)) {
+    throw RuntimeError{"Shared memory logger requires a name"sv};
+  }
+  auto capacity = settings.log.queue_capacity != 0 ? static_cast<size_t>(settings.log.queue_capacity) : CAPACITY;
+  return Segment::create(settings.log.shm_name, capacity);
+}
+
+// note! we want to keep the most recent records (e.g. a crash)
+auto get_overflow_policy(auto &settings) {
+  if (std::empty(settings.log.overflow_policy)) {
+    return Overflow::DROP_OLDEST;
+  }
+  return get_overflow(settings);
+}
+
+auto now() {
+  struct timespec time = {};
+  ::clock_gettime(CLOCK_REALTIME, &time);
+  return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Logger::Logger(Settings const &settings) : segment_{create_segment(settings)}, overflow_{get_overflow_policy(settings)} {
+  auto message = fmt::format(R"(logging: shm (name="{}", capacity={}))"sv, segment_.name(), segment_.capacity());
+  (*this)(Level::INFO, message);
+}
+
+// note! waits for an attached consumer (a consumer may otherwise still attach and read what remains)
+Logger::~Logger() {
+  auto deadline = now() + drain_timeout;
+  while (segment_.size() != 0 && segment_.header().consumer_pid.load(std::memory_order_acquire) != 0 && now() < deadline) {
+    std::this_thread::sleep_for(DRAIN_SLEEP);
+  }
+  if (segment_.size() == 0) {
+    segment_.unlink();
+  }
+}
+
+void Logger::operator()(Level level, std::string_view const &message) {
+  auto timestamp = now();
+  while (!segment_.try_push(level, timestamp, THREAD_ID, message, overflow_ != Overflow::DROP_OLDEST)) [[unlikely]] {
+    if (!is_blocking(overflow_, level)) {
+      dropped_(level);
+      segment_.header().dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    std::this_thread::sleep_for(BLOCK_SLEEP);
+  }
+}
+
+Stats Logger::get_stats() const {
+  auto result = Handler::get_stats();
+  dropped_.get(result);
+  result.queue_depth = segment_.size();
+  return result;
+}
+
+// note! published records already survive the process
+bool Logger::drain(std::chrono::nanoseconds, bool) {
+  return true;
+}
+
+}  // namespace shm
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,48 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+
+#include "roq/logging/handler.hpp"
+#include "roq/logging/overflow.hpp"
+#include "roq/logging/settings.hpp"
+
+#include "roq/logging/shm/segment.hpp"
+
+namespace roq {
+namespace logging {
+namespace shm {
+
+// shared memory logger
+// - records are written to a named shared memory segment, another process (roq-logging-tail) formats and writes the log files
+// - no backend thread, no file i/o and no pattern formatting in this process
+// - the segment keeps the most recent records, the oldest are overwritten when it is full (default, drop oldest)
+// - the other overflow policies drop newest (or block) instead of overwriting what an attached consumer hasn't consumed yet
+// - messages lost by an attached consumer are counted in the segment and reported by the consumer
+// - published records survive the process (the consumer can still read the most recent records after a crash)
+// - the segment is removed on a clean shutdown once an attached consumer has consumed everything (bounded by the drain timeout)
+// note! without an attached consumer the oldest records are always overwritten (nothing would otherwise ever make room)
+// note! a segment with records not yet consumed is kept (a consumer can still attach after the process has exited)
+
+struct Logger final : public Handler {
+  explicit Logger(Settings const &);
+
+  ~Logger() override;
+
+ protected:
+  void operator()(Level, std::string_view const &message) override;
+
+  Stats get_stats() const override;
+
+  bool drain(std::chrono::nanoseconds timeout, bool signal) override;
+
+ private:
+  Segment segment_;
+  Overflow const overflow_;
+  Dropped dropped_;
+};
+
+}  // namespace shm
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,247 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/shm/segment.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "roq/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+namespace shm {
+
+// === CONSTANTS ===
+
+namespace {
+auto const MIN_CAPACITY = 4096uz;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! shm_open requires a single leading slash and no other slashes
+auto get_path(std::string_view const &name) {
+  if (std::empty(name) || name.find('/') != name.npos) {
+    throw RuntimeError{R"(Invalid shared memory name: "{}")"sv, name};
+  }
+  return fmt::format("/{}"sv, name);
+}
+
+auto now() {
+  struct timespec time = {};
+  ::clock_gettime(CLOCK_REALTIME, &time);
+  return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+}
+
+auto map(std::string_view const &name, int fd, size_t length) {
+  auto address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    auto error = errno;
+    ::close(fd);
+    throw RuntimeError{R"(Unable to map shared memory: name="{}", error="{}")"sv, name, std::strerror(error)};
+  }
+  return static_cast<std::byte *>(address);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+Segment Segment::create(std::string_view const &name, size_t capacity) {
+  auto path = get_path(name);
+  capacity = std::bit_ceil(std::max(capacity, MIN_CAPACITY));
+  if (capacity > MAX_CAPACITY) {
+    throw RuntimeError{"Invalid shared memory capacity: {} (max is {})"sv, capacity, MAX_CAPACITY};
+  }
+  // note! a consumer still attached to an existing segment will see the producer die and can then attach to the new segment
+  ::shm_unlink(path.c_str());
+  auto fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    throw RuntimeError{R"(Unable to create shared memory: name="{}", error="{}")"sv, name, std::strerror(errno)};
+  }
+  if (::ftruncate(fd, static_cast<off_t>(HEADER_SIZE + capacity)) < 0) {
+    auto error = errno;
+    ::close(fd);
+    ::shm_unlink(path.c_str());
+    throw RuntimeError{R"(Unable to size shared memory: name="{}", error="{}")"sv, name, std::strerror(error)};
+  }
+  auto address = map(name, fd, HEADER_SIZE + capacity);
+  auto header = new (address) Header{};  // note! the memory is zero-filled
+  (*header).version = VERSION;
+  (*header).header_size = HEADER_SIZE;
+  (*header).capacity = capacity;
+  (*header).producer_pid = ::getpid();
+  (*header).created = now().count();
+  (*header).magic.store(MAGIC, std::memory_order_release);
+  return Segment{name, fd, capacity, address};
+}
+
+Segment Segment::open(std::string_view const &name) {
+  auto path = get_path(name);
+  auto fd = ::shm_open(path.c_str(), O_RDWR | O_CLOEXEC, 0);
+  if (fd < 0) {
+    throw RuntimeError{R"(Unable to open shared memory: name="{}", error="{}")"sv, name, std::strerror(errno)};
+  }
+  struct stat stat = {};
+  if (::fstat(fd, &stat) < 0 || static_cast<size_t>(stat.st_size) < HEADER_SIZE) {
+    ::close(fd);
+    throw RuntimeError{R"(Invalid shared memory (too small): name="{}")"sv, name};
+  }
+  auto length = static_cast<size_t>(stat.st_size);
+  auto address = map(name, fd, length);
+  auto &header = *reinterpret_cast<Header *>(address);
+  auto validate = [&]() -> std::string_view {
+    if (header.magic.load(std::memory_order_acquire) != MAGIC) {
+      return "magic"sv;
+    }
+    if (header.version != VERSION) {
+      return "version"sv;
+    }
+    if (header.header_size != HEADER_SIZE || !std::has_single_bit(header.capacity) || (HEADER_SIZE + header.capacity) != length) {
+      return "layout"sv;
+    }
+    return {};
+  };
+  auto error = validate();
+  if (!std::empty(error)) {
+    auto version = header.version;
+    ::munmap(address, length);
+    ::close(fd);
+    throw RuntimeError{R"(Invalid shared memory ({}): name="{}", version={} (expected {}))"sv, error, name, version, VERSION};
+  }
+  return Segment{name, fd, static_cast<size_t>(header.capacity), address};
+}
+
+Segment::Segment(std::string_view const &name, int fd, size_t capacity, std::byte *address)
+    : name_{name}, fd_{fd}, capacity_{capacity}, mask_{capacity - 1}, address_{address}, header_{reinterpret_cast<Header *>(address)},
+      data_{address + HEADER_SIZE} {
+}
+
+Segment::Segment(Segment &&other)
+    : name_{std::move(other.name_)}, fd_{std::exchange(other.fd_, -1)}, capacity_{other.capacity_}, mask_{other.mask_},
+      address_{std::exchange(other.address_, nullptr)}, header_{std::exchange(other.header_, nullptr)}, data_{std::exchange(other.data_, nullptr)},
+      buffer_{std::move(other.buffer_)} {
+}
+
+Segment::~Segment() {
+  if (address_ != nullptr) {
+    ::munmap(address_, HEADER_SIZE + capacity_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+// note! lock-free (compare-and-swap), the oldest records are evicted before reserving
+bool Segment::try_push(Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message, bool protect) {
+  auto length = std::min(std::size(message), max_length());
+  auto size = get_size(length);
+  auto &header = *header_;
+  auto write_index = header.write_index.load(std::memory_order_relaxed);
+  size_t padding = {};
+  while (true) {
+    auto contiguous = capacity_ - (write_index & mask_);
+    padding = contiguous < size ? contiguous : size_t{0};
+    auto required = write_index + padding + size;
+    if ((required - header.tail_index.load(std::memory_order_acquire)) > capacity_) [[unlikely]] {
+      if (!evict(required - capacity_, protect)) {
+        return false;
+      }
+      write_index = header.write_index.load(std::memory_order_relaxed);
+      continue;
+    }
+    if (header.write_index.compare_exchange_weak(write_index, required, std::memory_order_acquire, std::memory_order_relaxed)) [[likely]] {
+      break;
+    }
+  }
+  // note! the consumer may still be copying an evicted record (it validates against the tail index after an acquire fence)
+  std::atomic_thread_fence(std::memory_order_release);
+  if (padding != 0) {
+    get_record(write_index).sequence.store(write_index | PUBLISHED | PADDING, std::memory_order_release);
+    write_index += padding;
+  }
+  auto &record = get_record(write_index);
+  std::atomic_ref{record.length}.store(static_cast<uint32_t>(length), std::memory_order_relaxed);  // note! see evict
+  record.thread_id = thread_id;
+  record.timestamp = timestamp.count();
+  record.level = level;
+  std::memcpy(reinterpret_cast<std::byte *>(&record + 1), std::data(message), length);
+  record.sequence.store(write_index | PUBLISHED, std::memory_order_release);
+  return true;
+}
+
+void Segment::unlink() {
+  ::shm_unlink(get_path(name_).c_str());
+}
+
+// note! advances the tail index past whole records until target has been reached (any producer may win the race)
+// note! the oldest record may still be written by another producer (a thread of this process, it will publish shortly)
+// note! records not yet consumed by an attached consumer are counted as dropped
+bool Segment::evict(uint64_t target, bool protect) {
+  auto &header = *header_;
+  auto attached = header.consumer_pid.load(std::memory_order_relaxed) != 0;
+  auto tail_index = header.tail_index.load(std::memory_order_acquire);
+  while (tail_index < target) {
+    auto consumed = !attached || tail_index < header.read_index.load(std::memory_order_acquire);
+    if (protect && !consumed) {
+      return false;
+    }
+    auto &record = get_record(tail_index);
+    auto sequence = record.sequence.load(std::memory_order_acquire);
+    size_t size = {};
+    if (sequence == (tail_index | PUBLISHED | PADDING)) {
+      size = capacity_ - (tail_index & mask_);
+    } else if (sequence == (tail_index | PUBLISHED)) {
+      size = get_size(std::atomic_ref{record.length}.load(std::memory_order_relaxed));
+    } else {
+      std::this_thread::yield();
+      tail_index = header.tail_index.load(std::memory_order_acquire);
+      continue;
+    }
+    // note! the length may have been overwritten if another producer has already moved the tail index (the exchange will then fail)
+    if (header.tail_index.compare_exchange_weak(tail_index, tail_index + size, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      if (!consumed && (sequence & PADDING) == 0) {
+        header.dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+      tail_index += size;
+    }
+  }
+  return true;
+}
+
+// note! seqlock, must be called after having copied the record
+bool Segment::is_evicted(uint64_t index) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return (*header_).tail_index.load(std::memory_order_relaxed) > index;
+}
+
+// note! best effort, scans for the next published record (a message could in theory contain what looks like a sequence)
+uint64_t Segment::find_next(uint64_t index) {
+  auto write_index = (*header_).write_index.load(std::memory_order_acquire);
+  for (auto next = index + ALIGNMENT; next < write_index; next += ALIGNMENT) {
+    auto sequence = get_record(next).sequence.load(std::memory_order_acquire);
+    if ((sequence & ~PADDING) == (next | PUBLISHED)) {
+      return next;
+    }
+  }
+  return write_index;
+}
+
+}  // namespace shm
+}  // namespace logging
+}  // namespace roq
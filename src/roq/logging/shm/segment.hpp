@@ -0,0 +1,208 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <sys/types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "roq/logging/level.hpp"
+
+namespace roq {
+namespace logging {
+namespace shm {
+
+// named shared memory ring ("/dev/shm/{name}") of variable length text records
+// - multiple producers (threads of the logging process) and a single consumer (another process, e.g. roq-logging-tail)
+// - producers reserve by advancing the write index (compare-and-swap), write the record and then publish it (its sequence)
+// - records are aligned to 8 bytes and always contiguous (a padding marker is inserted when wrapping, it extends to the end)
+// - the ring keeps the most recent records: producers evict the oldest records (the tail index) when they need room
+// - consumed records are left in place until evicted, the consumer only advances the read index
+// - the segment outlives the producing process (the most recent records survive a crash, also when no consumer was attached)
+// - the consumer detects records evicted while reading (the tail index has moved past them) and skips them
+// - a record which was reserved but never published (the producer died) is skipped by scanning for the next sequence
+// note! the layout is versioned, the consumer must reject what it doesn't understand
+
+struct ROQ_PUBLIC Segment final {
+  static constexpr uint64_t const MAGIC = 0x474f4c2d514f52;  // note! "ROQ-LOG" (little-endian)
+  static constexpr uint32_t const VERSION = 2;
+  static constexpr size_t const HEADER_SIZE = 4096;
+  static constexpr size_t const ALIGNMENT = 8;
+  static constexpr size_t const CACHE_LINE_SIZE = 64;
+
+  struct alignas(CACHE_LINE_SIZE) Header final {
+    std::atomic<uint64_t> magic;  // note! published last (the header is then complete)
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t capacity;  // note! bytes, power of 2
+    pid_t producer_pid;
+    int64_t created;  // note! nanoseconds since epoch
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> write_index;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_index;  // note! oldest record still in the ring
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> read_index;
+    std::atomic<pid_t> consumer_pid;  // note! 0 means none
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> dropped;
+  };
+
+  static_assert(sizeof(Header) <= HEADER_SIZE);
+  static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<pid_t>::is_always_lock_free);  // note! must be address-free
+
+  // note! sequence = index | flags (the index is aligned), anything else means not (yet) published (e.g. a previous lap)
+  static constexpr uint64_t const PUBLISHED = 1;
+  static constexpr uint64_t const PADDING = 2;  // note! only the sequence is written (may be smaller than a record)
+  static constexpr size_t const MAX_CAPACITY = size_t{1} << 28;
+
+  struct Record final {
+    std::atomic<uint64_t> sequence;  // note! written last (the record is then published)
+    uint32_t length;                 // note! message (atomic_ref, see evict)
+    uint32_t thread_id;
+    int64_t timestamp;  // note! nanoseconds since epoch
+    Level level;
+  };
+
+  static_assert(sizeof(Record) % ALIGNMENT == 0);
+
+  // note! copied from the record (the record may be evicted while the consumer is reading it)
+  struct Entry final {
+    int64_t timestamp;  // note! nanoseconds since epoch
+    uint32_t thread_id;
+    Level level;
+  };
+
+  // producer (throws)
+  // note! replaces an existing segment (a consumer still attached to the old segment will continue to read from it)
+  static Segment create(std::string_view const &name, size_t capacity);
+
+  // consumer (throws)
+  static Segment open(std::string_view const &name);
+
+  Segment(Segment &&);
+  Segment(Segment const &) = delete;
+
+  ~Segment();
+
+  std::string_view name() const { return name_; }
+  size_t capacity() const { return capacity_; }
+
+  // note! the largest message we can ever accept (guarantees progress when wrapping)
+  size_t max_length() const { return (capacity_ / 2) - sizeof(Record); }
+
+  Header &header() { return *header_; }
+  Header const &header() const { return *header_; }
+
+  // producer
+
+  // note! the oldest records are evicted when the ring is full
+  // note! protect means an attached consumer must not lose what it hasn't consumed yet (false is then returned)
+  // note! message is truncated to max length
+  bool try_push(Level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message, bool protect);
+
+  // note! removes the name (the memory is released when the last process has unmapped it)
+  void unlink();
+
+  // consumer
+
+  enum class Status {
+    OK,
+    EMPTY,
+    PENDING,  // note! the next record has been reserved but not yet published
+  };
+
+  // note! the callback will be called with (Entry const &, std::string_view const &message), returns the number of records
+  // note! skip_pending should only be used when the producer is known to have died
+  template <typename Callback>
+  size_t read(Callback &&callback, size_t max_count, Status &status, bool skip_pending = false) {
+    auto &header = *header_;
+    auto read_index = header.read_index.load(std::memory_order_relaxed);
+    size_t count = 0;
+    status = Status::OK;
+    while (count < max_count) {
+      // note! evicted before we could read them (the producer has counted them as dropped if we were attached)
+      auto tail_index = header.tail_index.load(std::memory_order_acquire);
+      if (read_index < tail_index) {
+        read_index = tail_index;
+      }
+      if (read_index == header.write_index.load(std::memory_order_acquire)) {
+        status = Status::EMPTY;
+        break;
+      }
+      auto &record = get_record(read_index);
+      auto sequence = record.sequence.load(std::memory_order_acquire);
+      size_t size = {};
+      if (sequence == (read_index | PUBLISHED | PADDING)) {
+        size = capacity_ - (read_index & mask_);
+      } else if (sequence == (read_index | PUBLISHED)) {
+        Entry entry{
+            .timestamp = record.timestamp,
+            .thread_id = record.thread_id,
+            .level = record.level,
+        };
+        auto length = std::min<size_t>(record.length, max_length());
+        buffer_.assign(reinterpret_cast<char const *>(&record + 1), length);
+        if (is_evicted(read_index)) {
+          continue;
+        }
+        std::string_view message{buffer_};
+        callback(entry, message);
+        ++count;
+        size = get_size(length);
+      } else {
+        if (is_evicted(read_index)) {
+          continue;
+        }
+        if (!skip_pending) {
+          status = Status::PENDING;
+          break;
+        }
+        // note! the producer died before publishing
+        size = find_next(read_index) - read_index;
+      }
+      read_index += size;
+      header.read_index.store(read_index, std::memory_order_release);
+    }
+    header.read_index.store(read_index, std::memory_order_release);
+    return count;
+  }
+
+  // note! bytes not yet consumed
+  size_t size() const {
+    auto write_index = (*header_).write_index.load(std::memory_order_acquire);
+    auto read_index = std::max((*header_).read_index.load(std::memory_order_acquire), (*header_).tail_index.load(std::memory_order_acquire));
+    return write_index - std::min(read_index, write_index);
+  }
+
+ protected:
+  Segment(std::string_view const &name, int fd, size_t capacity, std::byte *address);
+
+  Record &get_record(uint64_t index) { return *reinterpret_cast<Record *>(&data_[index & mask_]); }
+
+  static size_t get_size(size_t length) { return (sizeof(Record) + length + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+  bool evict(uint64_t target, bool protect);
+
+  bool is_evicted(uint64_t index) const;
+
+  uint64_t find_next(uint64_t index);
+
+ private:
+  std::string name_;
+  int fd_ = -1;
+  size_t capacity_ = {};
+  size_t mask_ = {};
+  std::byte *address_ = nullptr;
+  Header *header_ = nullptr;
+  std::byte *data_ = nullptr;
+  std::string buffer_;  // note! consumer only
+};
+
+}  // namespace shm
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,104 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/sinks.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+#include "roq/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+
+// === HELPERS ===
+
+namespace {
+auto trim(std::string_view const &value) {
+  auto first = value.find_first_not_of(" \t"sv);
+  if (first == value.npos) {
+    return std::string_view{};
+  }
+  auto last = value.find_last_not_of(" \t"sv);
+  return value.substr(first, last - first + 1);
+}
+
+auto parse_type(std::string_view const &item, std::string_view const &type) {
+  if (type == "stdout"sv) {
+    return SinkOptions::Type::STDOUT;
+  }
+  if (type == "stderr"sv) {
+    return SinkOptions::Type::STDERR;
+  }
+  if (type == "file"sv) {
+    return SinkOptions::Type::FILE;
+  }
+  throw RuntimeError{R"(Invalid sink: "{}" (unknown type "{}"))"sv, item, type};
+}
+
+auto parse_level(std::string_view const &item, std::string_view const &level) {
+  if (std::empty(level) || level == "debug"sv) {
+    return Level::DEBUG;
+  }
+  if (level == "info"sv) {
+    return Level::INFO;
+  }
+  if (level == "warning"sv) {
+    return Level::WARNING;
+  }
+  if (level == "error"sv) {
+    return Level::ERROR;
+  }
+  if (level == "critical"sv) {
+    return Level::CRITICAL;
+  }
+  throw RuntimeError{R"(Invalid sink: "{}" (unknown level "{}"))"sv, item, level};
+}
+
+auto parse_item(std::string_view const &item) {
+  auto equal = item.find('=');
+  auto head = trim(item.substr(0, equal));
+  auto path = equal == item.npos ? std::string_view{} : trim(item.substr(equal + 1));
+  auto at = head.find('@');
+  auto type = parse_type(item, trim(head.substr(0, at)));
+  auto level = parse_level(item, at == head.npos ? std::string_view{} : trim(head.substr(at + 1)));
+  if ((type == SinkOptions::Type::FILE) != !std::empty(path)) {
+    throw RuntimeError{R"(Invalid sink: "{}" (path is required for file, and only for file))"sv, item};
+  }
+  return SinkOptions{
+      .type = type,
+      .level = level,
+      .path = std::string{path},
+  };
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+std::vector<SinkOptions> get_sinks(Settings const &settings) {
+  std::vector<SinkOptions> result;
+  auto remaining = settings.log.sinks;
+  while (!std::empty(remaining)) {
+    auto comma = remaining.find(',');
+    auto item = trim(remaining.substr(0, comma));
+    remaining = comma == remaining.npos ? std::string_view{} : remaining.substr(comma + 1);
+    if (std::empty(item)) {
+      continue;
+    }
+    auto sink = parse_item(item);
+    // note! two writers would corrupt the file (and the rotation), messages would otherwise be duplicated
+    // note! the primary sink is stdout when there is no log path
+    auto primary = sink.type == SinkOptions::Type::FILE ? sink.path == settings.log.path : (sink.type == SinkOptions::Type::STDOUT && std::empty(settings.log.path));
+    auto duplicate = std::ranges::any_of(result, [&](auto &other) { return other.type == sink.type && other.path == sink.path; });
+    if (primary || duplicate) {
+      throw RuntimeError{R"(Invalid sink: "{}" (already used))"sv, item};
+    }
+    result.emplace_back(std::move(sink));
+  }
+  return result;
+}
+
+}  // namespace logging
+}  // namespace roq
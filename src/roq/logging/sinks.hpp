@@ -0,0 +1,38 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <string>
+#include <vector>
+
+#include "roq/logging/level.hpp"
+#include "roq/logging/settings.hpp"
+
+namespace roq {
+namespace logging {
+
+// additional sinks (fan-out)
+// - comma separated list of type[@level][=path], e.g. "stderr@error,file@warning=/var/log/alerts.log"
+// - type is one of stdout, stderr or file (path is required, and only allowed, for file)
+// - level is the minimum level (one of debug, info, warning, error or critical), default is debug
+// - validated when parsed (throws), each destination can only be used once (including the primary sink)
+// note! the primary sink (the log path, or stdout if empty) always receives all messages
+
+struct SinkOptions final {
+  enum class Type {
+    STDOUT,
+    STDERR,
+    FILE,
+  };
+
+  Type type = {};
+  Level level = {};
+  std::string path;  // note! only file
+};
+
+ROQ_PUBLIC std::vector<SinkOptions> get_sinks(Settings const &);
+
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,160 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/site.hpp"
+
+#include <array>
+#include <bit>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <fmt/format.h>
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+
+// === CONSTANTS ===
+
+namespace {
+auto const INITIAL_TABLE_SIZE = 16384uz;  // note! power of 2
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! fnv-1a
+struct Hasher final {
+  void operator()(std::string_view const &value) {
+    for (auto c : value) {
+      result = (result ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+  }
+  void operator()(uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      result = (result ^ ((value >> (i * 8)) & 0xff)) * 0x100000001b3;
+    }
+  }
+
+  uint64_t result = 0xcbf29ce484222325;
+};
+
+// note! same key as the registry (a format string may be used with different levels, e.g. by debug_info)
+auto create_id(Level level, size_t verbosity, Prefix prefix, auto &fmt) {
+  Hasher hasher;
+  hasher(uint64_t{static_cast<uint8_t>(level)});
+  hasher(uint64_t{verbosity});
+  hasher(uint64_t{static_cast<uint8_t>(prefix)});
+  hasher(fmt.file_name);
+  hasher(uint64_t{fmt.line});
+  hasher(std::string_view{std::data(fmt.str), std::size(fmt.str)});
+  return hasher.result;
+}
+
+// note! only accessed when registering (or enumerating) sites
+struct Registry final {
+  std::mutex mutex;
+  std::deque<Site> sites;  // note! stable addresses
+  std::deque<std::string> headers;
+  std::deque<std::unique_ptr<std::atomic<Site const *>[]>> slots;  // note! tables are never released (lock-free readers)
+  std::deque<detail::SiteTable> tables;
+};
+
+Registry &get_registry() {
+  static Registry registry;
+  return registry;
+}
+
+// note! compare-and-swap, probing continues if the slot has already been taken
+void insert(detail::SiteTable const &table, Site const &site) {
+  auto hash = detail::get_site_hash(std::data(site.format), site.line, site.verbosity, table.shift);
+  for (auto i = hash;; ++i) {
+    Site const *expected = nullptr;
+    if (table.slots[i & table.mask].compare_exchange_strong(expected, &site, std::memory_order_release, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+// note! the load factor must never exceed 1/2 (probing relies on empty slots)
+detail::SiteTable const &get_table(Registry &registry, size_t count) {
+  auto &current = *detail::site_table.load(std::memory_order_relaxed);
+  auto size = current.mask + 1;
+  if ((count * 2) <= size) [[likely]] {
+    return current;
+  }
+  size *= 2;
+  auto &slots = registry.slots.emplace_back(std::make_unique<std::atomic<Site const *>[]>(size));
+  auto &result = registry.tables.emplace_back(detail::SiteTable{
+      .shift = static_cast<uint32_t>(64 - std::countr_zero(size)),
+      .mask = size - 1,
+      .slots = slots.get(),
+  });
+  for (auto &site : registry.sites) {
+    insert(result, site);
+  }
+  detail::site_table.store(&result, std::memory_order_release);
+  return result;
+}
+
+std::array<std::atomic<Site const *>, INITIAL_TABLE_SIZE> initial_slots;
+
+detail::SiteTable const INITIAL_TABLE{
+    .shift = 64 - std::countr_zero(INITIAL_TABLE_SIZE),
+    .mask = INITIAL_TABLE_SIZE - 1,
+    .slots = std::data(initial_slots),
+};
+}  // namespace
+
+// === EXTERN ===
+
+namespace detail {
+constinit std::atomic<SiteTable const *> site_table{&INITIAL_TABLE};
+}  // namespace detail
+
+// === IMPLEMENTATION ===
+
+std::vector<Site const *> get_sites() {
+  auto &registry = get_registry();
+  std::lock_guard lock{registry.mutex};
+  std::vector<Site const *> result;
+  result.reserve(std::size(registry.sites));
+  for (auto &site : registry.sites) {
+    result.emplace_back(&site);
+  }
+  return result;
+}
+
+namespace detail {
+Site const &register_site(Level level, size_t verbosity, Prefix prefix, format_str const &fmt) {
+  auto &registry = get_registry();
+  std::lock_guard lock{registry.mutex};
+  // note! another thread may have won the race
+  auto site = find_site(*site_table.load(std::memory_order_acquire), level, verbosity, prefix, fmt);
+  if (site != nullptr) {
+    return *site;
+  }
+  auto &table = get_table(registry, std::size(registry.sites) + 1);
+  auto &result = registry.sites.emplace_back();
+  result.id = create_id(level, verbosity, prefix, fmt);
+  result.index = static_cast<uint32_t>(std::size(registry.sites));
+  result.level = level;
+  result.verbosity = verbosity;
+  result.prefix = prefix;
+  result.file_name = fmt.file_name;
+  result.line = static_cast<uint32_t>(fmt.line);
+  result.format = {std::data(fmt.str), std::size(fmt.str)};
+  auto &header = registry.headers.emplace_back(fmt::format("L{} {}:{}] "sv, verbosity, get_basename(fmt.file_name), fmt.line));
+  if (prefix == Prefix::DEBUG) {
+    header.append("DEBUG: "sv);
+  }
+  result.header = header;
+  insert(table, result);
+  return result;
+}
+}  // namespace detail
+
+}  // namespace logging
+}  // namespace roq
@@ -4,17 +4,26 @@
 
 #include <unistd.h>
 
+#include <cstdio>
+#include <ctime>
+
 #include <spdlog/async.h>
 #include <spdlog/spdlog.h>
 
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/sinks/sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include "roq/logging.hpp"
+
 #include "roq/logging/shared.hpp"
+#include "roq/logging/sinks.hpp"
+#include "roq/logging/thread_options.hpp"
 
 using namespace std::literals;
+using namespace std::chrono_literals;
 
 namespace roq {
 namespace logging {
@@ -25,16 +34,98 @@ namespace spdlog {
 namespace {
 auto const SPDLOG_QUEUE_SIZE = 1048576uz;
 auto const SPDLOG_THREAD_COUNT = 1uz;
+auto const DROPPED_REPORT_FREQ = std::chrono::nanoseconds{1s}.count();
+auto const DRAIN_SLEEP = std::chrono::nanoseconds{100us}.count();
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+template <typename T>
+auto create_async_logger(auto &settings) -> std::shared_ptr<::spdlog::logger> {
+  if (std::empty(settings.log.path)) {
+    return ::spdlog::stdout_logger_st<T>("spdlog"s);
+  }
+  return ::spdlog::rotating_logger_st<T>("spdlog"s, std::string{settings.log.path}, settings.log.max_size, settings.log.max_files, settings.log.rotate_on_open);
+}
+
+// note! spdlog can only discard the oldest message, other policies are implemented by tracking the queue depth before logging
+auto create_async_logger(auto &settings, Overflow overflow) {
+  if (overflow == Overflow::DROP_OLDEST) {
+    return create_async_logger<::spdlog::async_factory_nonblock>(settings);
+  }
+  return create_async_logger<::spdlog::async_factory>(settings);
+}
+
+// note! shared by the out and err loggers (and used from the backend thread when asynchronous)
+auto create_sink(auto &settings, SinkOptions const &options) -> ::spdlog::sink_ptr {
+  switch (options.type) {
+    using enum SinkOptions::Type;
+    case STDOUT:
+      return std::make_shared<::spdlog::sinks::stdout_sink_mt>();
+    case STDERR:
+      return std::make_shared<::spdlog::sinks::stderr_sink_mt>();
+    case FILE:
+      // note! spdlog doesn't allow rotation without a max size
+      if (settings.log.max_size == 0) {
+        return std::make_shared<::spdlog::sinks::basic_file_sink_mt>(options.path);
+      }
+      return std::make_shared<::spdlog::sinks::rotating_file_sink_mt>(options.path, settings.log.max_size, settings.log.max_files, settings.log.rotate_on_open);
+  }
+  return {};
+}
+
+auto get_level(Level level) {
+  switch (level) {
+    using enum Level;
+    case DEBUG:
+      return ::spdlog::level::debug;
+    case INFO:
+      return ::spdlog::level::info;
+    case WARNING:
+      return ::spdlog::level::warn;
+    case ERROR:
+      return ::spdlog::level::err;
+    case CRITICAL:
+      return ::spdlog::level::critical;
+  }
+  return ::spdlog::level::debug;
+}
 }  // namespace
 
 // === IMPLEMENTATION ===
 
+// note! approximate queue depth: incremented by producers, decremented when the backend thread hands the message to the sinks
+// reason: spdlog protects its queue by a mutex (queue_size), the check must be combined with the push and it is used when draining from a signal handler
+// note! messages overwritten by spdlog (drop_oldest) are never decremented
+struct Logger::Depth final : public ::spdlog::sinks::sink {
+  void log(::spdlog::details::log_msg const &) override { value.fetch_sub(1, std::memory_order_relaxed); }
+  void flush() override {}
+  void set_pattern(std::string const &) override {}
+  void set_formatter(std::unique_ptr<::spdlog::formatter>) override {}
+
+  std::atomic<uint64_t> value = {};
+};
+
 Logger::Logger(Settings const &settings) {
   auto terminal = ::isatty(fileno(stdout));
   // note! non-interactive sessions are asynchronous
   auto interactive = std::empty(settings.log.path) && terminal != 0;
+  ThreadOptions thread_options{settings};
+  auto overflow = get_overflow(settings);
   if (!interactive) {
-    ::spdlog::init_thread_pool(SPDLOG_QUEUE_SIZE, SPDLOG_THREAD_COUNT);
+    capacity_ = settings.log.queue_capacity != 0 ? static_cast<size_t>(settings.log.queue_capacity) : SPDLOG_QUEUE_SIZE;
+    overflow_ = overflow;
+    ::spdlog::init_thread_pool(capacity_, SPDLOG_THREAD_COUNT, [thread_options]() {
+      // note! the worker must not log (it could block on its own queue)
+      auto error = thread_options();
+      if (!std::empty(error)) {
+        fmt::print(stderr, "logging: {}\n"sv, error);
+      }
+    });
+    thread_pool_ = ::spdlog::thread_pool();
+    metrics_freq_ = settings.log.metrics_freq;
+    next_dump_ = log::detail::get_coarse_time() + metrics_freq_.count();
     if (settings.log.flush_freq.count() != 0) {
       ::spdlog::flush_every(std::chrono::duration_cast<std::chrono::seconds>(settings.log.flush_freq));
     }
@@ -63,11 +154,25 @@ Logger::Logger(Settings const &settings) {
         err = ::spdlog::stderr_logger_st("spdlog_err"s);
       }
     } else {
-      out = ::spdlog::stdout_logger_st<::spdlog::async_factory>("spdlog"s);
+      out = create_async_logger(settings, overflow_);
     }
   } else {
-    out = ::spdlog::rotating_logger_st<::spdlog::async_factory>(
-        "spdlog"s, std::string{settings.log.path}, settings.log.max_size, settings.log.max_files, settings.log.rotate_on_open);
+    out = create_async_logger(settings, overflow_);
+  }
+  // note! spdlog hands the message to all sinks (by reference), each sink filters by its own level
+  // note! each sink owns its formatter (the message is formatted once per sink)
+  for (auto &item : get_sinks(settings)) {
+    auto sink = create_sink(settings, item);
+    (*sink).set_level(get_level(item.level));
+    (*out).sinks().emplace_back(sink);
+    // note! the err logger already writes to stderr
+    if (err && item.type != SinkOptions::Type::STDERR) {
+      (*err).sinks().emplace_back(sink);
+    }
+  }
+  if (thread_pool_) {
+    depth_ = std::make_shared<Depth>();
+    (*out).sinks().emplace_back(depth_);
   }
   if (!std::empty(settings.log.pattern)) {
     (*out).set_pattern(std::string{settings.log.pattern});
@@ -95,11 +200,15 @@ Logger::Logger(Settings const &settings) {
     err_ = out_;
   }
   auto message = fmt::format("logging: {}"sv, interactive ? "sync"sv : "async"sv);
+  acquire(Level::INFO, true);
   (*out_).log(::spdlog::level::info, message);
 }
 
 Logger::~Logger() {
   try {
+    if (overflow_ != Overflow::BLOCK) {
+      report(true);
+    }
     // note! not thread-safe
     if (out_ != nullptr) {
       (*out_).flush();
@@ -114,6 +223,16 @@ Logger::~Logger() {
 }
 
 void Logger::operator()(Level level, std::string_view const &message) {
+  if (overflow_ != Overflow::BLOCK) [[unlikely]] {
+    report();
+  }
+  if (!acquire(level)) {
+    dropped_(level);
+    return;
+  }
+  if (metrics_freq_.count() != 0) [[unlikely]] {
+    dump();
+  }
   switch (level) {
     using enum Level;
     case DEBUG:
@@ -134,6 +253,120 @@ void Logger::operator()(Level level, std::string_view const &message) {
   }
 }
 
+// note! write and flush time are not available (spdlog owns the backend thread)
+Stats Logger::get_stats() const {
+  auto result = Handler::get_stats();
+  dropped_.get(result);
+  if (thread_pool_) {
+    result.queue_depth = (*thread_pool_).queue_size();
+    update_queue_depth_max(result.queue_depth);
+    result.queue_depth_max = queue_depth_max_.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+// note! spdlog's flush is asynchronous, it is queued behind all other messages
+// note! signal: spdlog's queue (queue_size) and flush (allocates) can't be used, we only wait for the depth to reach zero
+// note! signal: messages overwritten by spdlog (drop_oldest) will cause a timeout
+bool Logger::drain(std::chrono::nanoseconds timeout, bool signal) {
+  auto deadline = detail::Metrics::now() + static_cast<uint64_t>(timeout.count());
+  if (signal) {
+    return depth_ && wait_empty(deadline);
+  }
+  try {
+    if (!thread_pool_) {
+      (*out_).flush();
+      if (err_ != out_) {
+        (*err_).flush();
+      }
+      return true;
+    }
+    if (!wait_empty(deadline)) {
+      return false;
+    }
+    (*out_).flush();
+    return wait_empty(deadline);
+  } catch (...) {
+    return false;
+  }
+}
+
+// note! async-signal-safe (atomic and nanosleep), empty means the backend thread has handed the last message to the sinks
+bool Logger::wait_empty(uint64_t deadline) const {
+  while ((*depth_).value.load(std::memory_order_acquire) != 0) {
+    if (detail::Metrics::now() >= deadline) {
+      return false;
+    }
+    struct timespec sleep = {
+        .tv_sec = 0,
+        .tv_nsec = DRAIN_SLEEP,
+    };
+    ::nanosleep(&sleep, nullptr);
+  }
+  return true;
+}
+
+// note! drop_oldest is managed by spdlog
+// note! returns false if the message must be dropped, force is used for synthetic messages
+bool Logger::acquire(Level level, bool force) {
+  if (!depth_ || !(*out_).should_log(get_level(level))) {
+    return true;
+  }
+  auto &depth = (*depth_).value;
+  auto queue_depth = depth.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (queue_depth <= capacity_ || force || is_blocking(overflow_, level)) [[likely]] {
+    update_queue_depth_max(queue_depth);
+    return true;
+  }
+  depth.fetch_sub(1, std::memory_order_relaxed);
+  return false;
+}
+
+// note! synthetic warning, rate-limited (any producer thread may win the race to report)
+void Logger::report(bool force) {
+  auto now = log::detail::get_coarse_time();
+  auto next = next_report_.load(std::memory_order_relaxed);
+  if (!force && now < next) [[likely]] {
+    return;
+  }
+  if (!next_report_.compare_exchange_strong(next, now + DROPPED_REPORT_FREQ, std::memory_order_acq_rel)) {
+    return;
+  }
+  auto message = dropped_.take();
+  if (overflow_ == Overflow::DROP_OLDEST) {
+    auto overrun = (*thread_pool_).overrun_counter();
+    if (overrun != overrun_) {
+      message = fmt::format("*** DROPPED {} MESSAGE(S) (OLDEST) ***"sv, overrun - overrun_);
+      overrun_ = overrun;
+    }
+  }
+  if (!std::empty(message)) {
+    acquire(Level::WARNING, true);
+    (*out_).log(::spdlog::level::warn, message);
+  }
+}
+
+// note! rate-limited (any producer thread may win the race to dump)
+void Logger::dump() {
+  auto now = log::detail::get_coarse_time();
+  auto next = next_dump_.load(std::memory_order_relaxed);
+  if (now < next) [[likely]] {
+    return;
+  }
+  if (!next_dump_.compare_exchange_strong(next, now + metrics_freq_.count(), std::memory_order_acq_rel)) {
+    return;
+  }
+  auto message = fmt::format("*** METRICS {} ***"sv, get_stats());
+  acquire(Level::INFO, true);
+  (*out_).log(::spdlog::level::info, message);
+}
+
+void Logger::update_queue_depth_max(uint64_t queue_depth) const {
+  auto current = queue_depth_max_.load(std::memory_order_relaxed);
+  while (queue_depth > current && !queue_depth_max_.compare_exchange_weak(current, queue_depth, std::memory_order_relaxed)) {
+  }
+}
+
 }  // namespace spdlog
 }  // namespace logging
 }  // namespace roq
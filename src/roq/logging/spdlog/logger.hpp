@@ -2,10 +2,17 @@
 
 #pragma once
 
+#include <spdlog/async.h>
 #include <spdlog/logger.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 #include "roq/logging/handler.hpp"
+#include "roq/logging/overflow.hpp"
 #include "roq/logging/settings.hpp"
+#include "roq/logging/static_handler.hpp"
 
 namespace roq {
 namespace logging {
@@ -16,12 +23,36 @@ struct Logger final : public Handler {
 
   ~Logger() override;
 
+  friend struct logging::StaticHandler;  // note! direct calls (ROQ_LOGGING_STATIC_HANDLER)
+
  protected:
   void operator()(Level, std::string_view const &message) override;
 
+  Stats get_stats() const override;
+
+  bool drain(std::chrono::nanoseconds timeout, bool signal) override;
+
+  bool wait_empty(uint64_t deadline) const;
+  bool acquire(Level, bool force = false);
+  void report(bool force = false);
+  void dump();
+  void update_queue_depth_max(uint64_t queue_depth) const;
+
+  struct Depth;
+
  private:
   ::spdlog::logger *out_ = nullptr;
   ::spdlog::logger *err_ = nullptr;
+  size_t capacity_ = {};
+  Overflow overflow_ = {};
+  std::shared_ptr<::spdlog::details::thread_pool> thread_pool_;
+  std::shared_ptr<Depth> depth_;  // note! only when asynchronous
+  Dropped dropped_;
+  std::atomic<int64_t> next_report_ = {};
+  size_t overrun_ = {};  // note! only accessed by the thread winning the race to report
+  std::chrono::nanoseconds metrics_freq_ = {};
+  std::atomic<int64_t> next_dump_ = {};
+  mutable std::atomic<uint64_t> queue_depth_max_ = {};  // note! sampled
 };
 
 }  // namespace spdlog
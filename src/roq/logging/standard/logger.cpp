@@ -4,6 +4,8 @@
 
 #include <fmt/format.h>
 
+#include <cstdio>
+
 #include "roq/logging/shared.hpp"
 
 using namespace std::literals;
@@ -32,6 +34,16 @@ void Logger::operator()(Level level, std::string_view const &message) {
   }
 }
 
+// note! stdout is buffered and abort will not flush it
+// note! fflush takes the stdio lock (not async-signal-safe, the crashing thread may hold it)
+bool Logger::drain(std::chrono::nanoseconds, bool signal) {
+  if (signal) {
+    return false;
+  }
+  std::fflush(stdout);
+  return true;
+}
+
 }  // namespace standard
 }  // namespace logging
 }  // namespace roq
@@ -4,6 +4,7 @@
 
 #include "roq/logging/handler.hpp"
 #include "roq/logging/settings.hpp"
+#include "roq/logging/static_handler.hpp"
 
 namespace roq {
 namespace logging {
@@ -12,8 +13,12 @@ namespace standard {
 struct Logger final : public Handler {
   explicit Logger(Settings const &);
 
+  friend struct logging::StaticHandler;  // note! direct calls (ROQ_LOGGING_STATIC_HANDLER)
+
  protected:
   void operator()(Level, std::string_view const &message) override;
+
+  bool drain(std::chrono::nanoseconds timeout, bool signal) override;
 };
 
 }  // namespace standard
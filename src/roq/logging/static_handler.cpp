@@ -0,0 +1,96 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/static_handler.hpp"
+
+#if defined(ROQ_LOGGING_STATIC_HANDLER)
+
+#include <typeinfo>
+
+#include "roq/logging/handler.hpp"
+
+#if defined(ROQ_LOGGING_STATIC_HANDLER_RING)
+#include "roq/logging/ring/logger.hpp"
+#elif defined(ROQ_LOGGING_STATIC_HANDLER_SPDLOG)
+#include "roq/logging/spdlog/logger.hpp"
+#else
+#include "roq/logging/standard/logger.hpp"
+#endif
+
+namespace roq {
+namespace logging {
+
+// === CONSTANTS ===
+
+namespace {
+#if defined(ROQ_LOGGING_STATIC_HANDLER_RING)
+using value_type = ring::Logger;
+#elif defined(ROQ_LOGGING_STATIC_HANDLER_SPDLOG)
+using value_type = spdlog::Logger;
+#else
+using value_type = standard::Logger;
+#endif
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! the bound type is final, an exact type match is therefore sufficient
+value_type *get_bound(Handler &handler) {
+  if (typeid(handler) == typeid(value_type)) [[likely]] {
+    return static_cast<value_type *>(&handler);
+  }
+  return nullptr;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+void StaticHandler::operator()(Level level, std::string_view const &message) {
+  auto &handler = Handler::get_instance();
+  auto bound = get_bound(handler);
+  if (bound) [[likely]] {
+    (*bound)(level, message);
+  } else {
+    handler(level, message);
+  }
+}
+
+std::span<char> StaticHandler::reserve(Level level) {
+  auto &handler = Handler::get_instance();
+  auto bound = get_bound(handler);
+  if (bound) [[likely]] {
+    return (*bound).reserve(level);
+  }
+  // note! the caller only checked the bound type
+  if (!handler.is_two_phase()) {
+    return {};
+  }
+  return handler.reserve(level);
+}
+
+void StaticHandler::commit(Level level, size_t length) {
+  auto &handler = Handler::get_instance();
+  auto bound = get_bound(handler);
+  if (bound) [[likely]] {
+    (*bound).commit(level, length);
+  } else {
+    handler.commit(level, length);
+  }
+}
+
+std::span<std::byte> StaticHandler::reserve_deferred(Level level, Codec const &codec, size_t length) {
+  auto &handler = Handler::get_instance();
+  auto bound = get_bound(handler);
+  if (bound) [[likely]] {
+    return (*bound).reserve_deferred(level, codec, length);
+  }
+  if (!handler.is_two_phase()) {
+    return {};
+  }
+  return handler.reserve_deferred(level, codec, length);
+}
+
+}  // namespace logging
+}  // namespace roq
+
+#endif
@@ -0,0 +1,72 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/stats.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace roq {
+namespace logging {
+
+// === HELPERS ===
+
+namespace {
+// note! only accessed when a producer thread starts or terminates, and when reading
+struct Registry final {
+  std::mutex mutex;
+  std::vector<detail::Metrics const *> live;
+  Stats retired;  // note! only the producer counters
+};
+
+Registry &get_registry() {
+  static Registry registry;
+  return registry;
+}
+
+void accumulate(Stats &stats, detail::Metrics const &metrics) {
+  for (size_t i = 0; i < Stats::LEVELS; ++i) {
+    stats.messages[i] += metrics.messages[i].load(std::memory_order_relaxed);
+    stats.bytes[i] += metrics.bytes[i].load(std::memory_order_relaxed);
+  }
+  for (size_t i = 0; i < Stats::LATENCY_BUCKETS; ++i) {
+    stats.latency[i] += metrics.latency[i].load(std::memory_order_relaxed);
+  }
+}
+}  // namespace
+
+// === EXTERN ===
+
+namespace detail {
+thread_local Metrics producer_metrics;
+}  // namespace detail
+
+// === IMPLEMENTATION ===
+
+namespace detail {
+Metrics::Metrics() {
+  auto &registry = get_registry();
+  std::lock_guard lock{registry.mutex};
+  registry.live.emplace_back(this);
+}
+
+Metrics::~Metrics() {
+  auto &registry = get_registry();
+  std::lock_guard lock{registry.mutex};
+  accumulate(registry.retired, *this);
+  std::erase(registry.live, this);
+}
+
+void Metrics::get(Stats &stats) {
+  auto &registry = get_registry();
+  std::lock_guard lock{registry.mutex};
+  stats.messages = registry.retired.messages;
+  stats.bytes = registry.retired.bytes;
+  stats.latency = registry.retired.latency;
+  for (auto metrics : registry.live) {
+    accumulate(stats, *metrics);
+  }
+}
+}  // namespace detail
+
+}  // namespace logging
+}  // namespace roq
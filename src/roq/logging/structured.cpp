@@ -0,0 +1,13 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/structured.hpp"
+
+namespace roq {
+namespace logging {
+
+// === EXTERN ===
+
+Encoding structured_encoding = Encoding::LOGFMT;
+
+}  // namespace logging
+}  // namespace roq
@@ -0,0 +1,28 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/tail/flags.hpp"
+
+#include <absl/flags/flag.h>
+
+#include <string>
+
+using namespace std::literals;
+
+ABSL_FLAG(  //
+    bool,
+    follow,
+    false,
+    "keep reading (also waits for the segment to be created and follows a restarted process)"s);
+
+namespace roq {
+namespace logging {
+namespace tail {
+
+bool Flags::follow() {
+  static bool const result = absl::GetFlag(FLAGS_follow);
+  return result;
+}
+
+}  // namespace tail
+}  // namespace logging
+}  // namespace roq
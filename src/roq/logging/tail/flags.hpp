@@ -0,0 +1,15 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+namespace roq {
+namespace logging {
+namespace tail {
+
+struct Flags final {
+  static bool follow();
+};
+
+}  // namespace tail
+}  // namespace logging
+}  // namespace roq
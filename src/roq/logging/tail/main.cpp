@@ -0,0 +1,227 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <fmt/format.h>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "roq/flags/args.hpp"
+
+#include "roq/logging/flags/settings.hpp"
+
+#include "roq/logging/ring/pattern.hpp"
+#include "roq/logging/ring/rotating_file.hpp"
+#include "roq/logging/ring/stream.hpp"
+
+#include "roq/logging/shm/segment.hpp"
+
+#include "roq/logging/tail/flags.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace roq::logging;
+
+// attaches to the shared memory segment of a process using the shm logger, formats and writes the log (stdout or rotated files)
+// usage: roq-logging-tail [--follow] [--log_path PATH] [--log_max_size BYTES] [--log_max_files COUNT] [--log_pattern PATTERN] [NAME]
+// - the name defaults to --log_shm_name (the process and the tail can then share a flag-file)
+// - without --follow: exits when everything published so far has been consumed
+// - with --follow: waits for the segment to be created and keeps reading, also when the process is restarted (a new segment)
+// - records published by a process which has since died (e.g. crashed) are still consumed
+// note! only a single consumer can be attached to a segment
+
+// === CONSTANTS ===
+
+namespace {
+auto const DESCRIPTION = "roq-logging-tail"sv;
+auto const MAX_BATCH_SIZE = 1024uz;
+auto const IDLE_SLEEP = 1ms;
+auto const ATTACH_SLEEP = 100ms;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+std::atomic<bool> STOP;
+
+void signal_handler(int) {
+  STOP.store(true, std::memory_order_relaxed);
+}
+
+struct Options final {
+  std::string_view name;
+  bool follow = {};
+};
+
+bool is_alive(pid_t pid) {
+  return ::kill(pid, 0) == 0 || errno == EPERM;
+}
+
+// note! another consumer may have died while attached
+void claim(shm::Segment &segment) {
+  auto &consumer_pid = segment.header().consumer_pid;
+  auto expected = consumer_pid.load(std::memory_order_acquire);
+  while (true) {
+    if (expected != 0 && expected != ::getpid() && is_alive(expected)) {
+      throw std::runtime_error{fmt::format(R"(Already attached: name="{}", consumer_pid={})"sv, segment.name(), expected)};
+    }
+    if (consumer_pid.compare_exchange_weak(expected, ::getpid(), std::memory_order_acq_rel)) {
+      return;
+    }
+  }
+}
+
+void unclaim(shm::Segment &segment) {
+  auto expected = ::getpid();
+  segment.header().consumer_pid.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+}
+
+std::optional<shm::Segment> attach(Options const &options) {
+  while (!STOP.load(std::memory_order_relaxed)) {
+    try {
+      auto segment = shm::Segment::open(options.name);
+      claim(segment);
+      return segment;
+    } catch (std::exception &) {
+      if (!options.follow) {
+        throw;
+      }
+    }
+    std::this_thread::sleep_for(ATTACH_SLEEP);
+  }
+  return {};
+}
+
+// note! a restarted process will have created a new segment (same name)
+bool is_replaced(shm::Segment const &segment, Options const &options) {
+  try {
+    auto other = shm::Segment::open(options.name);
+    return other.header().created != segment.header().created || other.header().producer_pid != segment.header().producer_pid;
+  } catch (std::exception &) {
+    return false;
+  }
+}
+
+struct Writer final {
+  explicit Writer(Settings const &settings) : pattern_{std::empty(settings.log.pattern) ? ring::Pattern::DEFAULT : settings.log.pattern} {
+    if (std::empty(settings.log.path)) {
+      sink_ = std::make_unique<ring::Stream>(STDOUT_FILENO);
+    } else {
+      sink_ = std::make_unique<ring::RotatingFile>(settings);
+    }
+    color_ = (*sink_).terminal();
+  }
+
+  void operator()(Level level, std::chrono::nanoseconds timestamp, uint32_t thread_id, std::string_view const &message) {
+    buffer_.clear();
+    pattern_(buffer_, level, timestamp, thread_id, message, color_);
+    buffer_.push_back('\n');
+    (*sink_).write(buffer_);
+    // note! same as the ring logger
+    if (level >= Level::WARNING) {
+      (*sink_).flush();
+    }
+  }
+
+  void operator()(shm::Segment::Entry const &entry, std::string_view const &message) {
+    (*this)(entry.level, std::chrono::nanoseconds{entry.timestamp}, entry.thread_id, message);
+  }
+
+  void flush() { (*sink_).flush(); }
+
+ private:
+  ring::Pattern pattern_;
+  std::unique_ptr<ring::Sink> sink_;
+  bool color_ = {};
+  std::string buffer_;
+};
+
+auto now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+}
+
+// note! synthetic messages use our own thread id
+void report(Writer &writer, std::string_view const &message) {
+  writer(Level::WARNING, now(), static_cast<uint32_t>(::gettid()), message);
+}
+
+void run(Settings const &settings, Options const &options) {
+  Writer writer{settings};
+  auto segment = attach(options);
+  uint64_t dropped = {};
+  while (segment && !STOP.load(std::memory_order_relaxed)) {
+    // note! must be checked before reading (a dead producer will never publish what it has reserved)
+    auto dead = !is_alive((*segment).header().producer_pid);
+    shm::Segment::Status status = {};
+    auto count = (*segment).read(writer, MAX_BATCH_SIZE, status, dead);
+    auto tmp = (*segment).header().dropped.load(std::memory_order_relaxed);
+    if (tmp != dropped) {
+      report(writer, fmt::format("*** DROPPED {} MESSAGE(S) ***"sv, tmp - dropped));
+      dropped = tmp;
+    }
+    if (count > 0) {
+      continue;
+    }
+    writer.flush();
+    if (status == shm::Segment::Status::EMPTY) {
+      if (!options.follow) {
+        break;
+      }
+      if (dead && is_replaced(*segment, options)) {
+        unclaim(*segment);
+        segment.reset();
+        auto next = attach(options);
+        if (next) {
+          segment.emplace(std::move(*next));
+        }
+        dropped = {};
+        continue;
+      }
+    }
+    std::this_thread::sleep_for(IDLE_SLEEP);
+  }
+  if (segment) {
+    unclaim(*segment);
+  }
+  writer.flush();
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+int main(int argc, char **argv) {
+  try {
+    roq::flags::Args args{argc, argv, DESCRIPTION, ROQ_VERSION};
+    flags::Settings settings{args};
+    auto params = args.get();
+    if (std::size(params) > 1) {
+      throw std::invalid_argument{"Expected at most one argument (the shared memory name)"s};
+    }
+    Options options{
+        .name = std::empty(params) ? settings.log.shm_name : params[0],
+        .follow = tail::Flags::follow(),
+    };
+    if (std::empty(options.name)) {
+      throw std::invalid_argument{"Missing shared memory name"s};
+    }
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+    run(settings, options);
+  } catch (std::exception &e) {
+    fmt::println(stderr, R"(Exception: what="{}")"sv, e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/thread_options.hpp"
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include "roq/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+
+// === CONSTANTS ===
+
+namespace {
+auto const MAX_NAME_LENGTH = 15uz;  // note! excluding the terminating null character
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+auto create_name(auto &settings) {
+  auto &result = settings.log.thread_name;
+  if (std::size(result) > MAX_NAME_LENGTH) {
+    throw RuntimeError{R"(Invalid thread name: "{}" (max length is {}))"sv, result, MAX_NAME_LENGTH};
+  }
+  return std::string{result};
+}
+
+auto parse_cpu(std::string_view const &value, std::string_view const &affinity) {
+  size_t result = {};
+  auto [ptr, ec] = std::from_chars(std::data(value), std::data(value) + std::size(value), result);
+  if (std::empty(value) || ec != std::errc{} || ptr != (std::data(value) + std::size(value)) || result >= CPU_SETSIZE) {
+    throw RuntimeError{R"(Invalid thread affinity: "{}" (expected cpu list, e.g. "1,3-4"))"sv, affinity};
+  }
+  return result;
+}
+
+// note! cpu list, e.g. "1,3-4"
+bool parse_affinity(std::string_view const &affinity, cpu_set_t &result) {
+  CPU_ZERO(&result);
+  if (std::empty(affinity)) {
+    return false;
+  }
+  auto remaining = affinity;
+  while (!std::empty(remaining)) {
+    auto comma = remaining.find(',');
+    auto item = remaining.substr(0, comma);
+    remaining = comma == remaining.npos ? std::string_view{} : remaining.substr(comma + 1);
+    auto dash = item.find('-');
+    auto first = parse_cpu(item.substr(0, dash), affinity);
+    auto last = dash == item.npos ? first : parse_cpu(item.substr(dash + 1), affinity);
+    if (last < first) {
+      throw RuntimeError{R"(Invalid thread affinity: "{}" (expected cpu list, e.g. "1,3-4"))"sv, affinity};
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      CPU_SET(cpu, &result);
+    }
+  }
+  return true;
+}
+
+int create_policy(auto &settings) {
+  auto &policy = settings.log.thread_policy;
+  if (std::empty(policy)) {
+    return settings.log.thread_priority != 0 ? SCHED_OTHER : -1;
+  }
+  if (policy == "other"sv) {
+    return SCHED_OTHER;
+  }
+  if (policy == "batch"sv) {
+    return SCHED_BATCH;
+  }
+  if (policy == "idle"sv) {
+    return SCHED_IDLE;
+  }
+  if (policy == "fifo"sv) {
+    return SCHED_FIFO;
+  }
+  if (policy == "rr"sv) {
+    return SCHED_RR;
+  }
+  throw RuntimeError{R"(Unknown thread policy: "{}")"sv, policy};
+}
+
+bool is_real_time(int policy) {
+  return policy == SCHED_FIFO || policy == SCHED_RR;
+}
+
+// note! real-time priority (fifo, rr) or nice value (other, batch, idle)
+int create_priority(auto &settings, int policy) {
+  auto result = settings.log.thread_priority;
+  auto [min, max] = is_real_time(policy) ? std::pair{::sched_get_priority_min(policy), ::sched_get_priority_max(policy)} : std::pair{-20, 19};
+  if (result < min || result > max) {
+    throw RuntimeError{"Invalid thread priority: {} (expected {}-{})"sv, result, min, max};
+  }
+  return result;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+ThreadOptions::ThreadOptions(Settings const &settings)
+    : name_{create_name(settings)}, has_affinity_{parse_affinity(settings.log.thread_affinity, affinity_)}, policy_{create_policy(settings)},
+      priority_{create_priority(settings, policy_)} {
+}
+
+// note! the backend thread must not log (it would register itself as a producer)
+std::string ThreadOptions::operator()() const {
+  std::string result;
+  auto append = [&](std::string_view const &what, int error) {
+    fmt::format_to(std::back_inserter(result), R"({}unable to set thread {} (error="{}"))"sv, std::empty(result) ? ""sv : ", "sv, what, std::strerror(error));
+  };
+  if (!std::empty(name_)) {
+    auto error = ::pthread_setname_np(::pthread_self(), name_.c_str());
+    if (error != 0) {
+      append("name"sv, error);
+    }
+  }
+  // note! 0 means the calling thread
+  if (has_affinity_ && ::sched_setaffinity(0, sizeof(affinity_), &affinity_) < 0) {
+    append("affinity"sv, errno);
+  }
+  if (policy_ < 0) {
+    return result;
+  }
+  struct sched_param param = {};
+  param.sched_priority = is_real_time(policy_) ? priority_ : 0;
+  if (::sched_setscheduler(0, policy_, &param) < 0) {
+    append("policy"sv, errno);
+    return result;
+  }
+  // note! the nice value is per-thread on Linux
+  if (!is_real_time(policy_) && ::setpriority(PRIO_PROCESS, static_cast<id_t>(::gettid()), priority_) < 0) {
+    append("priority"sv, errno);
+  }
+  return result;
+}
+
+}  // namespace logging
+}  // namespace roq
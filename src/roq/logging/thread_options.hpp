@@ -0,0 +1,35 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#pragma once
+
+#include "roq/compat.hpp"
+
+#include <sched.h>
+
+#include <string>
+
+#include "roq/logging/settings.hpp"
+
+namespace roq {
+namespace logging {
+
+// backend thread options (name, cpu affinity, scheduling policy and priority)
+// - validated when constructed (throws)
+// - applied by the backend thread itself (failures are returned as text, empty on success)
+// note! empty settings leave the thread unchanged
+
+struct ROQ_PUBLIC ThreadOptions final {
+  explicit ThreadOptions(Settings const &);
+
+  std::string operator()() const;
+
+ private:
+  std::string const name_;
+  cpu_set_t affinity_ = {};
+  bool const has_affinity_;
+  int const policy_;  // note! -1 means unchanged
+  int const priority_;
+};
+
+}  // namespace logging
+}  // namespace roq
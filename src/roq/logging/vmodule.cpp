@@ -0,0 +1,154 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include "roq/logging/vmodule.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "roq/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace logging {
+
+// === HELPERS ===
+
+namespace {
+struct Pattern final {
+  std::string glob;
+  size_t verbosity = {};
+  bool full_path = {};
+};
+
+// note! only accessed when (re)configuring or when a call-site must update its cached decision
+struct State final {
+  std::mutex mutex;
+  std::vector<Pattern> patterns;
+};
+
+State &get_state() {
+  static State state;
+  return state;
+}
+
+auto trim(std::string_view const &value) {
+  auto first = value.find_first_not_of(" \t"sv);
+  if (first == value.npos) {
+    return std::string_view{};
+  }
+  auto last = value.find_last_not_of(" \t"sv);
+  return value.substr(first, last - first + 1);
+}
+
+auto parse(std::string_view const &value) {
+  std::vector<Pattern> result;
+  auto remaining = value;
+  while (!std::empty(remaining)) {
+    auto comma = remaining.find(',');
+    auto item = trim(remaining.substr(0, comma));
+    remaining = comma == remaining.npos ? std::string_view{} : remaining.substr(comma + 1);
+    if (std::empty(item)) {
+      continue;
+    }
+    auto equal = item.rfind('=');
+    if (equal == item.npos) {
+      throw RuntimeError{R"(Invalid vmodule: "{}" (expected pattern=N))"sv, item};
+    }
+    auto glob = trim(item.substr(0, equal));
+    auto number = trim(item.substr(equal + 1));
+    size_t verbosity = {};
+    auto [ptr, ec] = std::from_chars(std::data(number), std::data(number) + std::size(number), verbosity);
+    if (std::empty(glob) || ec != std::errc{} || ptr != (std::data(number) + std::size(number))) {
+      throw RuntimeError{R"(Invalid vmodule: "{}" (expected pattern=N))"sv, item};
+    }
+    result.push_back({
+        .glob = std::string{glob},
+        .verbosity = verbosity,
+        .full_path = glob.find('/') != glob.npos,
+    });
+  }
+  return result;
+}
+
+// note! '*' matches any sequence, '?' matches any single character
+bool match(std::string_view const &glob, std::string_view const &text) {
+  size_t i = 0, j = 0;
+  auto star = glob.npos;
+  size_t mark = 0;
+  while (j < std::size(text)) {
+    if (i < std::size(glob) && (glob[i] == '?' || glob[i] == text[j])) {
+      ++i;
+      ++j;
+    } else if (i < std::size(glob) && glob[i] == '*') {
+      star = i++;
+      mark = j;
+    } else if (star != glob.npos) {
+      i = star + 1;
+      j = ++mark;
+    } else {
+      return false;
+    }
+  }
+  while (i < std::size(glob) && glob[i] == '*') {
+    ++i;
+  }
+  return i == std::size(glob);
+}
+
+auto get_module(std::string_view const &file_name) {
+  auto result = file_name;
+  auto slash = result.rfind('/');
+  if (slash != result.npos) {
+    result = result.substr(slash + 1);
+  }
+  auto dot = result.find('.');
+  if (dot != result.npos) {
+    result = result.substr(0, dot);
+  }
+  return result;
+}
+}  // namespace
+
+// === EXTERN ===
+
+namespace detail {
+std::atomic<bool> has_vmodule = false;
+std::atomic<uint32_t> vmodule_generation = 0;
+}  // namespace detail
+
+// === IMPLEMENTATION ===
+
+void set_vmodule(std::string_view const &value) {
+  auto patterns = parse(value);
+  auto &state = get_state();
+  std::lock_guard lock{state.mutex};
+  auto has_vmodule = !std::empty(patterns);
+  state.patterns = std::move(patterns);
+  detail::has_vmodule.store(has_vmodule, std::memory_order_relaxed);
+  detail::vmodule_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace detail {
+uint64_t update_vmodule(Site const &site) {
+  auto &state = get_state();
+  std::lock_guard lock{state.mutex};
+  auto module = get_module(site.file_name);
+  auto result = uint64_t{vmodule_generation.load(std::memory_order_relaxed)} << 32;
+  for (auto &item : state.patterns) {
+    if (match(item.glob, item.full_path ? site.file_name : module)) {
+      result |= VMODULE_MATCHED | std::min<uint64_t>(item.verbosity, VMODULE_VERBOSITY);
+      break;
+    }
+  }
+  site.vmodule.store(result, std::memory_order_relaxed);
+  return result;
+}
+}  // namespace detail
+
+}  // namespace logging
+}  // namespace roq
@@ -17,6 +17,8 @@
 
 #include "roq/logging/flags/settings.hpp"
 
+#include "roq/logging/ring/pattern.hpp"
+
 using namespace std::literals;
 
 namespace roq {
@@ -32,33 +34,69 @@ namespace {
 // - %f = fraction (microseconds)
 // - %t = thread (int)
 // - %v = message
-auto const DEFAULT_LOG_PATTERN = "%L%m%d %T.%f %t %^%v%$"sv;  // XXX TODO spdlog specific
+auto const DEFAULT_LOG_PATTERN = "%L%m%d %T.%f %t %^%v%$"sv;  // note! spdlog (the ring logger uses ring::Pattern::DEFAULT)
 }  // namespace
 
 // === HELPERS ===
 
 namespace {
-auto create_settings(auto &settings) {
+// note! the ring logger supports nanoseconds (%F), spdlog is limited to microseconds
+auto create_settings(auto &settings, std::string_view const &type) {
   auto result = settings;
   if (std::empty(result.log.pattern)) {
-    result.log.pattern = DEFAULT_LOG_PATTERN;
+    result.log.pattern = type == "spdlog"sv ? DEFAULT_LOG_PATTERN : logging::ring::Pattern::DEFAULT;
   }
   return result;
 }
+
+auto is_compressed(auto &compression) {
+  return !std::empty(compression) && compression != "none"sv;
+}
+
+auto has_wait_strategy(auto &wait_strategy) {
+  return !std::empty(wait_strategy) && wait_strategy != "sleep"sv;
+}
+
+// note! spdlog doesn't support the binary format (or memory-mapped files, compression, wait strategies, deferred formatting)
+// note! a shared memory name means the log files are written by another process (roq-logging-tail)
+auto get_handler_type(auto &settings) {
+  if (!std::empty(settings.log.shm_name)) {
+    return "shm"sv;
+  }
+  if (settings.log.format == "binary"sv || settings.log.mmap || settings.log.deferred || is_compressed(settings.log.compression) || is_compressed(settings.log.compression_rotated) ||
+      has_wait_strategy(settings.log.wait_strategy)) {
+    return "ring"sv;
+  }
+  return "spdlog"sv;
+}
+
+auto create_metadata(auto &info) -> logging::Metadata {
+  return {
+      .package_name = info.package_name,
+      .host = info.host,
+      .build_version = info.build_version,
+      .build_number = info.build_number,
+      .build_type = info.build_type,
+      .git_hash = info.git_hash,
+      .compile_date = info.compile_date,
+      .compile_time = info.compile_time,
+  };
+}
 }  // namespace
 
 // === IMPLEMENTATION ===
 
 Service::Service(args::Parser const &args, logging::Settings const &settings, Info const &info)
     : package_name_{info.package_name}, host_{info.host}, build_version_{info.build_version}, build_number_{info.build_number}, build_type_{info.build_type},
-      git_hash_{info.git_hash}, compile_date_{info.compile_date}, compile_time_{info.compile_time}, args_{args}, settings_{create_settings(settings)},
-      handler_2_{logging::Factory::create("spdlog"sv, settings_)}, handler_{*handler_2_}, logger_{args_, settings_} {
+      git_hash_{info.git_hash}, compile_date_{info.compile_date}, compile_time_{info.compile_time}, args_{args},
+      settings_{create_settings(settings, get_handler_type(settings))},
+      handler_2_{logging::Factory::create(get_handler_type(settings_), settings_, create_metadata(info))}, handler_{*handler_2_}, logger_{args_, settings_} {
 }
 
 Service::Service(args::Parser const &args, logging::Settings const &settings, logging::Handler &handler, Info const &info)
     : package_name_{info.package_name}, host_{info.host}, build_version_{info.build_version}, build_number_{info.build_number}, build_type_{info.build_type},
-      git_hash_{info.git_hash}, compile_date_{info.compile_date}, compile_time_{info.compile_time}, args_{args}, settings_{create_settings(settings)},
-      handler_{handler}, logger_{args_, settings_} {
+      git_hash_{info.git_hash}, compile_date_{info.compile_date}, compile_time_{info.compile_time}, args_{args},
+      settings_{create_settings(settings, get_handler_type(settings))}, handler_{handler}, logger_{args_, settings_} {
 }
 
 int Service::run() {
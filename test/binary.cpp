@@ -0,0 +1,164 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/factory.hpp"
+
+#include "roq/logging/binary/decoder.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+struct Lines final : public binary::Decoder::Handler {
+  void operator()(std::vector<std::pair<std::string, std::string>> const &metadata) override { metadata_ = metadata; }
+  void operator()(std::string_view const &line) override { lines_.emplace_back(line); }
+
+  std::vector<std::pair<std::string, std::string>> metadata_;
+  std::vector<std::string> lines_;
+};
+}  // namespace
+
+TEST_CASE("binary_round_trip", "[binary]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.max_files = 1;
+  settings.log.deferred = true;
+  settings.log.format = "binary"sv;
+  {
+    Metadata metadata{
+        .package_name = "roq-logging-test"sv,
+        .host = {},
+        .build_version = {},
+        .build_number = {},
+        .build_type = {},
+        .git_hash = {},
+        .compile_date = {},
+        .compile_time = {},
+    };
+    auto handler = Factory::create("ring"sv, settings, metadata);
+    log::info("hello {} {} {} {}"sv, 1, 2.5, 'c', true);
+    log::info("text {}"sv, "abc"sv);
+    log::info("duration {}"sv, std::chrono::seconds{3});
+    errno = EAGAIN;
+    log::system_error("failed {}"sv, -3);
+  }
+  auto buffer = read_file(path);
+  Lines collector;
+  binary::Decoder decoder{collector};
+  CHECK(decoder(buffer) == std::size(buffer));
+  REQUIRE(std::size(collector.metadata_) > 0);
+  CHECK(collector.metadata_[0].first == "package_name"sv);
+  CHECK(collector.metadata_[0].second == "roq-logging-test"sv);
+  REQUIRE(std::size(collector.lines_) == 5);
+  CHECK(collector.lines_[0].ends_with(" logging: async (ring)"sv));
+  CHECK(collector.lines_[1].ends_with("] hello 1 2.5 c true"sv));
+  CHECK(collector.lines_[2].ends_with("] text abc"sv));
+  CHECK(collector.lines_[3].ends_with("] duration 3s"sv));
+  CHECK(collector.lines_[4].ends_with(fmt::format("] {} [{}] failed -3"sv, std::strerror(EAGAIN), EAGAIN)));
+}
+
+// note! eager messages would be encoded as text
+TEST_CASE("binary_requires_deferred", "[binary]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.format = "binary"sv;
+  CHECK_THROWS_AS(Factory::create("ring"sv, settings), RuntimeError);
+}
+
+TEST_CASE("binary_truncated", "[binary]") {
+  Lines collector;
+  binary::Decoder decoder{collector};
+  std::string buffer;
+  buffer.push_back(static_cast<char>(binary::Tag::HEADER));
+  buffer.append(binary::MAGIC);
+  CHECK(decoder(buffer) == 0);
+}
+
+// note! records may end with zero bytes (no arguments, or an argument encoded as zero)
+TEST_CASE("binary_mmap_reopen", "[binary]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.max_size = 1048576;
+  settings.log.mmap = true;
+  settings.log.deferred = true;
+  settings.log.format = "binary"sv;
+  for (size_t i = 0; i < 2; ++i) {
+    auto handler = Factory::create("ring"sv, settings);
+    log::info("first"sv);
+    log::info("index={}"sv, 0);
+  }
+  auto buffer = read_file(path);
+  Lines collector;
+  binary::Decoder decoder{collector};
+  CHECK(decoder(buffer) == std::size(buffer));
+  REQUIRE(std::size(collector.lines_) == 6);  // note! includes the initial message
+  for (size_t i = 0; i < 2; ++i) {
+    CHECK(collector.lines_[i * 3 + 1].ends_with("] first"sv));
+    CHECK(collector.lines_[i * 3 + 2].ends_with("] index=0"sv));
+  }
+}
+
+// note! the memory-mapped file keeps its preallocated (zero-filled) tail when the process crashes
+TEST_CASE("binary_mmap_crash", "[binary]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  auto pid = ::fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    try {
+      Settings settings;
+      settings.log.path = path;
+      settings.log.max_size = 1048576;
+      settings.log.mmap = true;
+      settings.log.deferred = true;
+      settings.log.format = "binary"sv;
+      auto handler = Factory::create("ring"sv, settings);
+      for (size_t i = 0; i < 100; ++i) {
+        log::info("index={}"sv, i);
+      }
+      (*handler).drain(std::chrono::seconds{1}, false);
+      ::raise(SIGKILL);
+    } catch (...) {
+    }
+    ::_exit(EXIT_FAILURE);  // note! not reached
+  }
+  int status = 0;
+  REQUIRE(::waitpid(pid, &status, 0) == pid);
+  CHECK(WIFSIGNALED(status));
+  auto buffer = read_file(path);
+  CHECK(std::size(buffer) == 1048576);
+  Lines collector;
+  binary::Decoder decoder{collector};
+  CHECK(decoder(buffer) == std::size(buffer));
+  REQUIRE(std::size(collector.lines_) == 101);  // note! includes the initial message
+  CHECK(collector.lines_[100].ends_with("] index=99"sv));
+  buffer.push_back(static_cast<char>(binary::Tag::TEXT));  // note! not allowed after the end
+  binary::Decoder decoder_2{collector};
+  CHECK_THROWS_AS(decoder_2(buffer), RuntimeError);
+}
@@ -0,0 +1,71 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "roq/flags/args.hpp"
+
+#include "roq/logging/logger.hpp"
+#include "roq/logging/shared.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+auto wait_for(size_t value) {
+  for (size_t i = 0; i < 500 && verbosity.load() != value; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  return verbosity.load();
+}
+}  // namespace
+
+TEST_CASE("control_signals", "[control]") {
+  roq::flags::Args args{my_argc, my_argv, "test"sv, "test"sv};
+  Settings settings;
+  settings.log.verbosity_signals = true;
+  Logger logger{args, settings, false};
+  REQUIRE(verbosity.load() == 0);
+  std::raise(SIGUSR1);
+  std::raise(SIGUSR1);
+  CHECK(verbosity.load() == 2);
+  std::raise(SIGUSR2);
+  std::raise(SIGUSR2);
+  std::raise(SIGUSR2);  // note! saturates
+  CHECK(verbosity.load() == 0);
+}
+
+TEST_CASE("control_file", "[control]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("control"sv);
+  auto write = [&](std::string_view const &content) {
+    auto tmp = fmt::format("{}.tmp"sv, path);
+    auto file = std::fopen(tmp.c_str(), "w");
+    REQUIRE(file != nullptr);
+    fmt::print(file, "{}"sv, content);
+    std::fclose(file);
+    REQUIRE(std::rename(tmp.c_str(), path.c_str()) == 0);  // note! atomic replace
+  };
+  write("verbosity=1\n"sv);
+  roq::flags::Args args{my_argc, my_argv, "test"sv, "test"sv};
+  Settings settings;
+  settings.log.control_file = path;
+  {
+    Logger logger{args, settings, false};
+    CHECK(verbosity.load() == 1);  // note! loaded on start
+    write("# comment\nverbosity = 3\n"sv);
+    CHECK(wait_for(3) == 3);
+    write("verbosity=0\n"sv);
+    CHECK(wait_for(0) == 0);
+  }
+}
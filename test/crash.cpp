@@ -0,0 +1,70 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "roq/flags/args.hpp"
+
+#include "roq/logging/logger.hpp"
+#include "roq/logging/settings.hpp"
+
+#include "roq/logging/crash.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+TEST_CASE("crash_path", "[crash]") {
+  CHECK(get_crash_path(""sv) == ""sv);
+  CHECK(get_crash_path("/tmp/test.log"sv) == "/tmp/test.crash"sv);
+  CHECK(get_crash_path("/tmp/test"sv) == "/tmp/test.crash"sv);
+  CHECK(get_crash_path("/tmp/some.dir/test"sv) == "/tmp/some.dir/test.crash"sv);
+  CHECK(get_crash_path("test.log"sv) == "test.crash"sv);
+}
+
+TEST_CASE("crash_report", "[crash]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  auto crash_path = get_crash_path(path);
+  auto pid = ::fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    // note! child (stderr is often /dev/null, e.g. systemd)
+    try {
+      auto fd = ::open("/dev/null", O_WRONLY);
+      ::dup2(fd, STDERR_FILENO);
+      roq::flags::Args args{my_argc, my_argv, "test"sv, "test"sv};
+      logging::Settings settings;
+      settings.log.path = path;
+      logging::Logger logger{args, settings};
+      ::raise(SIGSEGV);
+    } catch (...) {
+    }
+    ::_exit(EXIT_FAILURE);  // note! not reached
+  }
+  int status = 0;
+  REQUIRE(::waitpid(pid, &status, 0) == pid);
+  CHECK(WIFSIGNALED(status));
+  CHECK(WTERMSIG(status) == SIGSEGV);
+  auto content = read_file(crash_path);
+  CHECK(content.starts_with("*** TERMINATION HANDLER ***\n"sv));
+  CHECK(content.find(fmt::format(", pid={}, thread_id={}\n"sv, pid, pid)) != content.npos);
+  CHECK(content.find("signal=11 (SIGSEGV)"sv) != content.npos);
+#if defined(__x86_64__)
+  CHECK(content.find("registers:\n  rip=0x"sv) != content.npos);
+#endif
+  CHECK(content.find("backtrace:\n[ 0] 0x"sv) != content.npos);
+}
@@ -2,6 +2,9 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <cstring>
+#include <limits>
+
 #include "roq/flags/args.hpp"
 
 #include "roq/logging.hpp"
@@ -35,3 +38,11 @@ TEST_CASE("logging_no_init_after", "[logging]") {
   log::error("error"sv);
   CHECK(true == true);
 }
+
+TEST_CASE("logging_error_text", "[logging]") {
+  for (int i = -1; i < 200; ++i) {
+    CHECK(get_error_text(i) == std::string_view{std::strerror(i)});
+  }
+  auto min = std::numeric_limits<int>::min();
+  CHECK(get_error_text(min) == std::string_view{std::strerror(min)});
+}
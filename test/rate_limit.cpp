@@ -0,0 +1,58 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+TEST_CASE("rate_limit_every_n", "[rate_limit]") {
+  Collector collector;
+  for (size_t i = 0; i < 10; ++i) {
+    log::info_every_n<4>("index={}"sv, i);
+  }
+  auto &messages = collector.messages_;
+  REQUIRE(std::size(messages) == 5);
+  CHECK(messages[0].ends_with("] index=0"sv));
+  CHECK(messages[1].ends_with("] *** SUPPRESSED 3 MESSAGE(S) ***"sv));
+  CHECK(messages[2].ends_with("] index=4"sv));
+  CHECK(messages[3].ends_with("] *** SUPPRESSED 3 MESSAGE(S) ***"sv));
+  CHECK(messages[4].ends_with("] index=8"sv));
+}
+
+TEST_CASE("rate_limit_every", "[rate_limit]") {
+  Collector collector;
+  auto helper = [](size_t index) { log::warn_every<20>("index={}"sv, index); };
+  for (size_t i = 0; i < 3; ++i) {
+    helper(i);
+  }
+  std::this_thread::sleep_for(50ms);
+  helper(3);
+  auto &messages = collector.messages_;
+  REQUIRE(std::size(messages) == 3);
+  CHECK(messages[0].ends_with("] index=0"sv));
+  CHECK(messages[1].ends_with("] *** SUPPRESSED 2 MESSAGE(S) ***"sv));
+  CHECK(messages[2].ends_with("] index=3"sv));
+}
+
+TEST_CASE("rate_limit_first_n", "[rate_limit]") {
+  Collector collector;
+  for (size_t i = 0; i < 10; ++i) {
+    log::error_first_n<2>("index={}"sv, i);
+  }
+  auto &messages = collector.messages_;
+  REQUIRE(std::size(messages) == 2);
+  CHECK(messages[0].ends_with("] index=0"sv));
+  CHECK(messages[1].ends_with("] index=1"sv));
+}
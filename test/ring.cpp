@@ -0,0 +1,758 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <latch>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(ROQ_LOGGING_ZSTD)
+#include <zstd.h>
+#endif
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/factory.hpp"
+#include "roq/logging/stats.hpp"
+
+#include "roq/logging/ring/clock.hpp"
+#include "roq/logging/ring/pattern.hpp"
+#include "roq/logging/ring/queue.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+auto push(ring::Queue &queue, std::string_view const &text) {
+  auto buffer = queue.try_reserve(std::size(text));
+  if (std::empty(buffer)) {
+    return false;
+  }
+  std::memcpy(std::data(buffer), std::data(text), std::size(text));
+  queue.commit(std::size(text));
+  return true;
+}
+
+auto pop(ring::Queue &queue) {
+  auto record = queue.front();
+  std::string result{reinterpret_cast<char const *>(std::data(record)), std::size(record)};
+  if (!std::empty(record)) {
+    queue.pop();
+  }
+  return result;
+}
+
+struct Throwing final {};
+}  // namespace
+
+template <>
+struct fmt::formatter<Throwing> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(Throwing const &, format_context &) const -> format_context::iterator { throw std::runtime_error{"format"}; }
+};
+
+TEST_CASE("ring_queue_simple", "[ring]") {
+  ring::Queue queue{256};
+  CHECK(queue.capacity() == 256);
+  CHECK(queue.empty() == true);
+  CHECK(std::empty(queue.front()) == true);
+  CHECK(push(queue, "hello"sv) == true);
+  CHECK(push(queue, "world"sv) == true);
+  CHECK(queue.empty() == false);
+  CHECK(pop(queue) == "hello"sv);
+  CHECK(pop(queue) == "world"sv);
+  CHECK(queue.empty() == true);
+}
+
+TEST_CASE("ring_queue_full", "[ring]") {
+  ring::Queue queue{256};
+  auto text = std::string(56, 'x');  // note! 64 bytes including prefix
+  CHECK(push(queue, text) == true);
+  CHECK(push(queue, text) == true);
+  CHECK(push(queue, text) == true);
+  CHECK(push(queue, text) == true);
+  CHECK(push(queue, text) == false);
+  CHECK(pop(queue) == text);
+  CHECK(push(queue, text) == true);
+  CHECK(push(queue, text) == false);
+}
+
+TEST_CASE("ring_queue_wrap", "[ring]") {
+  ring::Queue queue{256};
+  for (size_t i = 0; i < 100; ++i) {
+    auto text = fmt::format("{:0{}}"sv, i, 1 + (i % 50));
+    REQUIRE(push(queue, text) == true);
+    REQUIRE(pop(queue) == text);
+  }
+  CHECK(queue.empty() == true);
+}
+
+TEST_CASE("ring_queue_threads", "[ring]") {
+  ring::Queue queue{4096};
+  auto const count = 100000uz;
+  std::thread producer{[&]() {
+    for (size_t i = 0; i < count; ++i) {
+      auto text = fmt::format("{}"sv, i);
+      while (!push(queue, text)) {
+      }
+    }
+  }};
+  size_t next = 0;
+  while (next < count) {
+    auto text = pop(queue);
+    if (std::empty(text)) {
+      continue;
+    }
+    REQUIRE(text == fmt::format("{}"sv, next));
+    ++next;
+  }
+  producer.join();
+  CHECK(queue.empty() == true);
+}
+
+TEST_CASE("ring_logger_threads", "[ring]") {
+  Settings settings;
+  auto handler = Factory::create("ring"sv, settings);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back([i]() {
+      for (size_t j = 0; j < 10; ++j) {
+        log::info("thread={}, index={}"sv, i, j);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+TEST_CASE("ring_logger_wait", "[ring]") {
+  for (auto wait_strategy : {"sleep"sv, "spin"sv, "yield"sv, "block"sv}) {
+    TemporaryDirectory directory;
+    auto path = directory.get_path("test.log"sv);
+    Settings settings;
+    settings.log.path = path;
+    settings.log.wait_strategy = wait_strategy;
+    settings.log.wait_spin_count = 100;
+    settings.log.wait_yield_count = 10;
+    {
+      auto handler = Factory::create("ring"sv, settings);
+      for (size_t i = 0; i < 100; ++i) {
+        log::info("index={}"sv, i);
+        if ((i % 10) == 0) {
+          std::this_thread::sleep_for(1ms);  // note! backend should reach the wait strategy
+        }
+      }
+    }
+    auto content = read_file(path);
+    CHECK(std::count(std::begin(content), std::end(content), '\n') == 101);  // note! includes the initial message
+    CHECK(content.ends_with("index=99\n"sv));
+  }
+}
+
+TEST_CASE("ring_logger_drain", "[ring]") {
+  for (auto wait_strategy : {"sleep"sv, "block"sv}) {
+    TemporaryDirectory directory;
+    auto path = directory.get_path("test.log"sv);
+    Settings settings;
+    settings.log.path = path;
+    settings.log.wait_strategy = wait_strategy;
+    {
+      auto handler = Factory::create("ring"sv, settings);
+      for (size_t i = 0; i < 1000; ++i) {
+        log::info("index={}"sv, i);
+      }
+      // note! everything must have been written before the handler is destroyed
+      CHECK((*handler).drain(1s, false) == true);
+      auto content = read_file(path);
+      CHECK(std::count(std::begin(content), std::end(content), '\n') == 1001);  // note! includes the initial message
+      CHECK(content.ends_with("index=999\n"sv));
+    }
+  }
+}
+
+// note! the first record is reserved (timestamped) before the second is committed by another thread, it must be written first
+TEST_CASE("ring_logger_in_flight", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    auto buffer = (*handler).reserve(Level::INFO);
+    REQUIRE(std::size(buffer) >= 5);
+    std::thread{[]() { log::info("second"sv); }}.join();
+    std::this_thread::sleep_for(10ms);  // note! backend thread must not write the second record
+    std::memcpy(std::data(buffer), "first", 5);
+    (*handler).commit(Level::INFO, 5);
+    CHECK((*handler).drain(1s, false) == true);
+    auto content = read_file(path);
+    auto first = content.find("] first\n"sv);
+    auto second = content.find("] second\n"sv);
+    REQUIRE(first != content.npos);
+    REQUIRE(second != content.npos);
+    CHECK(first < second);
+  }
+}
+
+#if defined(ROQ_LOGGING_STATIC_HANDLER)
+// note! the ring logger is either the bound handler (direct calls) or reached through the virtual fallback
+TEST_CASE("ring_logger_static_handler", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    StaticHandler static_handler;
+    static_handler(Level::INFO, "direct"sv);
+    if (static_handler.is_two_phase()) {
+      auto buffer = static_handler.reserve(Level::INFO);
+      REQUIRE(std::size(buffer) >= 8);
+      std::memcpy(std::data(buffer), "reserved", 8);
+      static_handler.commit(Level::INFO, 8);
+    }
+    log::info("formatted={}"sv, 123);
+    CHECK((*handler).drain(1s, false) == true);
+    auto content = read_file(path);
+    CHECK(content.find("] direct\n"sv) != content.npos);
+    CHECK((content.find("] reserved\n"sv) != content.npos) == static_handler.is_two_phase());
+    CHECK(content.find("] formatted=123\n"sv) != content.npos);
+  }
+}
+#endif
+
+TEST_CASE("ring_logger_overflow", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.queue_capacity = 4096;
+  settings.log.overflow_policy = "drop_below_level"sv;
+  std::string padding(1000, 'x');  // note! exceeds what is reserved (the caller then retries)
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    for (size_t i = 0; i < 10000; ++i) {
+      if ((i % 100) == 0) {
+        log::warn("index={}"sv, i);
+      } else if ((i % 2) != 0) {
+        log::info("index={} {}"sv, i, padding);
+      } else {
+        log::info("index={}"sv, i);
+      }
+    }
+  }
+  std::istringstream file{read_file(path)};
+  size_t info = {}, warning = {}, dropped = {};
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.find("index="sv) != line.npos) {
+      ++(line.starts_with('W') ? warning : info);
+    }
+    auto offset = line.find("*** DROPPED "sv);
+    if (offset != line.npos) {
+      CHECK(line.starts_with('W'));
+      CHECK(line.find("WARNING="sv) == line.npos);
+      dropped += std::stoul(line.substr(offset + 12));
+    }
+  }
+  CHECK(warning == 100);
+  CHECK((info + dropped) == 9900);
+  settings.log.overflow_policy = "drop_oldest"sv;  // note! not supported
+  CHECK_THROWS_AS(Factory::create("ring"sv, settings), RuntimeError);
+}
+
+// note! the record length is stored as uint32_t (and limited to half the capacity)
+TEST_CASE("ring_logger_queue_capacity", "[ring]") {
+  Settings settings;
+  settings.log.queue_capacity = 1024;
+  CHECK_THROWS_AS(Factory::create("ring"sv, settings), RuntimeError);
+  settings.log.queue_capacity = uint64_t{1} << 34;
+  CHECK_THROWS_AS(Factory::create("ring"sv, settings), RuntimeError);
+}
+
+// note! more threads than queues (the last queue is shared), the block policy must not lose any messages
+TEST_CASE("ring_logger_shared", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.queue_capacity = 4096;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    std::latch latch{300};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 300; ++i) {
+      threads.emplace_back([&latch, i]() {
+        log::info("thread={}"sv, i);
+        latch.arrive_and_wait();  // note! all threads are alive (no queue can be reused)
+        for (size_t j = 0; j < 100; ++j) {
+          log::info("thread={}, index={}"sv, i, j);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  auto content = read_file(path);
+  CHECK(std::count(std::begin(content), std::end(content), '\n') == 30301);  // note! includes the initial message
+}
+
+TEST_CASE("ring_logger_metrics", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.metrics_freq = 10ms;
+  metrics = true;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    auto before = (*handler).get_stats();
+    for (size_t i = 0; i < 100; ++i) {
+      log::info("index={}"sv, i);
+      log::warn("index={}"sv, i);
+    }
+    std::this_thread::sleep_for(50ms);  // note! backend should dump
+    auto after = (*handler).get_stats();
+    auto info = static_cast<size_t>(Level::INFO), warning = static_cast<size_t>(Level::WARNING);
+    CHECK((after.messages[info] - before.messages[info]) == 100);
+    CHECK((after.messages[warning] - before.messages[warning]) == 100);
+    CHECK((after.bytes[info] - before.bytes[info]) >= (100 * std::size("index=0"sv)));
+    uint64_t latency = {};
+    for (size_t i = 0; i < Stats::LATENCY_BUCKETS; ++i) {
+      latency += after.latency[i] - before.latency[i];
+    }
+    CHECK(latency == 200);
+    CHECK(after.get_latency(0.5) <= after.get_latency(1.0));
+    CHECK(after.queue_depth_max > 0);
+    CHECK(after.write_count >= 200);
+    CHECK(after.flush_count > 0);
+  }
+  metrics = false;
+  auto content = read_file(path);
+  CHECK(content.find("*** METRICS {messages=["sv) != content.npos);
+}
+
+// note! producer counters are per thread (and retained when the thread terminates)
+TEST_CASE("ring_logger_metrics_threads", "[ring]") {
+  Settings settings;
+  metrics = true;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    auto before = (*handler).get_stats();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+      threads.emplace_back([]() {
+        for (size_t j = 0; j < 100; ++j) {
+          log::info("index={}"sv, j);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto after = (*handler).get_stats();
+    auto info = static_cast<size_t>(Level::INFO);
+    CHECK((after.messages[info] - before.messages[info]) == 400);
+  }
+  metrics = false;
+}
+
+// note! the backend thread must not block beyond the next periodic task
+TEST_CASE("ring_logger_metrics_idle", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.wait_strategy = "block"sv;
+  settings.log.wait_spin_count = 1;
+  settings.log.wait_yield_count = 1;
+  settings.log.metrics_freq = 10ms;
+  metrics = true;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    std::this_thread::sleep_for(100ms);  // note! backend should dump while idle
+  }
+  metrics = false;
+  auto content = read_file(path);
+  size_t count = {};
+  for (auto pos = content.find("*** METRICS"sv); pos != content.npos; pos = content.find("*** METRICS"sv, pos + 1)) {
+    ++count;
+  }
+  CHECK(count >= 2);
+}
+
+TEST_CASE("ring_logger_long_message", "[ring]") {
+  Settings settings;
+  auto handler = Factory::create("ring"sv, settings);
+  auto text = std::string(100000, 'x');  // note! exceeds what can be reserved
+  log::info("{}"sv, text);
+  log::info(""sv);
+}
+
+// note! the queue must remain usable if the formatter throws (nothing has been committed)
+TEST_CASE("ring_logger_format_throws", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  auto text = std::string(1000, 'x');  // note! exceeds what is reserved
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    CHECK_THROWS_AS(log::info("{}"sv, Throwing{}), std::runtime_error);
+    log::info("hello"sv);
+    log::info("{}"sv, text);
+    CHECK((*handler).drain(1s, false) == true);  // note! the failed reservation must not hold back the backend thread
+  }
+  auto content = read_file(path);
+  CHECK(content.find("] hello\n"sv) != content.npos);
+  CHECK(content.find(fmt::format("] {}\n"sv, text)) != content.npos);
+}
+
+TEST_CASE("ring_logger_deferred", "[ring]") {
+  Settings settings;
+  settings.log.deferred = true;
+  auto handler = Factory::create("ring"sv, settings);
+  log::info("deferred: {} {} {}"sv, 1, 2.5, 'c');
+  log::info("eager: {}"sv, "text"sv);
+  log::info("deferred: {:%S}"sv, std::chrono::seconds{3});
+  log::info("deferred: {} {}"sv, 1);  // note! invalid format string
+}
+
+TEST_CASE("ring_logger_sinks", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  auto alerts = directory.get_path("alerts.log"sv);
+  auto sinks = fmt::format("file@warning={}"sv, alerts);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.sinks = sinks;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    log::info("hello {}"sv, 1);
+    log::warn("hello {}"sv, 2);
+    log::error("hello {}"sv, 3);
+  }
+  auto content = read_file(path);
+  CHECK(std::count(std::begin(content), std::end(content), '\n') == 4);  // note! includes the initial message
+  CHECK(content.find("hello 1\n"sv) != content.npos);
+  auto content_2 = read_file(alerts);
+  CHECK(std::count(std::begin(content_2), std::end(content_2), '\n') == 2);
+  CHECK(content_2.find("hello 1\n"sv) == content_2.npos);
+  // note! formatted once
+  CHECK(content.ends_with(content_2));
+}
+
+TEST_CASE("ring_clock", "[ring]") {
+  ring::Clock clock;
+  auto now = [] {
+    struct timespec time = {};
+    ::clock_gettime(CLOCK_REALTIME, &time);
+    return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+  };
+  std::chrono::nanoseconds previous = {};
+  for (size_t i = 0; i < 3; ++i) {
+    auto before = now();
+    auto ticks = clock.now();
+    auto after = now();
+    auto timestamp = clock(ticks);
+    CHECK(timestamp >= (before - 100us));
+    CHECK(timestamp <= (after + 100us));
+    CHECK(timestamp >= previous);
+    previous = timestamp;
+    std::this_thread::sleep_for(10ms);
+    clock.calibrate();
+    CHECK(clock(clock.now()) >= previous);  // note! never backwards
+  }
+}
+
+TEST_CASE("ring_pattern", "[ring]") {
+  auto timestamp = std::chrono::seconds{1700000000} + std::chrono::nanoseconds{123456789};
+  auto time = std::time_t{1700000000};
+  struct tm tm = {};
+  ::localtime_r(&time, &tm);
+  std::array<char, 64> date_time;
+  auto length = std::strftime(std::data(date_time), std::size(date_time), "%m%d %H:%M:%S", &tm);
+  auto format = [&](std::string_view const &pattern, Level level, bool color = false) {
+    ring::Pattern compiled{pattern};
+    std::string result;
+    compiled(result, level, timestamp, 1234, "hello"sv, color);
+    return result;
+  };
+  CHECK(format("%L%m%d %T.%F %t %^%v%$"sv, Level::INFO) == fmt::format("I{}.123456789 1234 hello"sv, std::string_view{std::data(date_time), length}));
+  CHECK(format("%L%m%d %T.%f %t %^%v%$"sv, Level::WARNING) == fmt::format("W{}.123456 1234 hello"sv, std::string_view{std::data(date_time), length}));
+  CHECK(format("[%l] %e %v 100%%"sv, Level::ERROR) == "[error] 123 hello 100%"sv);
+  CHECK(format("%E.%F"sv, Level::DEBUG) == "1700000000.123456789"sv);
+  CHECK(format("%^%v%$"sv, Level::CRITICAL, true) == "\e[0;101mhello\e[0m"sv);
+  CHECK(format(""sv, Level::INFO) == ""sv);
+  CHECK_THROWS_AS(ring::Pattern{"%"sv}, RuntimeError);
+  CHECK_THROWS_AS(ring::Pattern{"%Q"sv}, RuntimeError);
+  // note! cached date/time must be updated when the second changes
+  ring::Pattern pattern{"%S.%e"sv};
+  std::string result;
+  pattern(result, Level::INFO, std::chrono::seconds{1700000000} + std::chrono::milliseconds{999}, 0, {}, false);
+  pattern(result, Level::INFO, std::chrono::seconds{1700000001} + std::chrono::milliseconds{1}, 0, {}, false);
+  CHECK(result == fmt::format("{:02}.999{:02}.001"sv, tm.tm_sec, (tm.tm_sec + 1) % 60));
+}
+
+TEST_CASE("ring_logger_mmap", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.max_size = 4096;
+  settings.log.max_files = 2;
+  settings.log.mmap = true;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    for (size_t i = 0; i < 1000; ++i) {
+      log::info("index={}"sv, i);
+    }
+  }
+  for (size_t i = 0; i <= settings.log.max_files; ++i) {
+    auto filename = i == 0 ? path : directory.get_path(fmt::format("test.{}.log"sv, i));
+    auto content = read_file(filename);
+    CHECK(std::size(content) > 0);
+    CHECK(std::size(content) <= settings.log.max_size);  // note! truncated
+    CHECK(content.find('\0') == content.npos);
+    CHECK(content.ends_with('\n'));
+    if (i == 0) {
+      CHECK(content.ends_with("index=999\n"sv));
+    }
+  }
+}
+
+// note! a file left behind by a crash still has the preallocated (zero-filled) tail
+TEST_CASE("ring_logger_mmap_reopen", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  {
+    std::ofstream file{path, std::ios::binary};
+    file << "before\n"sv << std::string(10000, '\0');
+  }
+  Settings settings;
+  settings.log.path = path;
+  settings.log.mmap = true;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    log::info("after"sv);
+  }
+  auto content = read_file(path);
+  CHECK(content.starts_with("before\n"sv));
+  CHECK(content.ends_with("after\n"sv));
+  CHECK(content.find('\0') == content.npos);
+}
+
+#if defined(ROQ_LOGGING_ZSTD)
+namespace {
+std::string decompress(std::string const &filename) {
+  auto content = read_file(filename);
+  auto context = ZSTD_createDCtx();
+  REQUIRE(context != nullptr);
+  ZSTD_inBuffer input{
+      .src = std::data(content),
+      .size = std::size(content),
+      .pos = 0,
+  };
+  std::string result;
+  while (input.pos < input.size) {
+    auto offset = std::size(result);
+    result.resize(offset + ZSTD_DStreamOutSize());
+    ZSTD_outBuffer output{
+        .dst = std::data(result) + offset,
+        .size = std::size(result) - offset,
+        .pos = 0,
+    };
+    auto error = ZSTD_decompressStream(context, &output, &input);
+    result.resize(offset + output.pos);
+    REQUIRE(!ZSTD_isError(error));
+  }
+  ZSTD_freeDCtx(context);
+  return result;
+}
+}  // namespace
+
+TEST_CASE("ring_logger_compression", "[ring]") {
+  for (auto compression : {"none"sv, "zstd"sv}) {
+    TemporaryDirectory directory;
+    auto path = directory.get_path("test.log"sv);
+    Settings settings;
+    settings.log.path = path;
+    settings.log.max_size = 4096;
+    settings.log.max_files = 2;
+    settings.log.compression = compression;
+    settings.log.compression_rotated = "zstd"sv;
+    settings.log.compression_level = 3;
+    {
+      auto handler = Factory::create("ring"sv, settings);
+      for (size_t i = 0; i < 1000; ++i) {
+        log::info("index={}"sv, i);
+      }
+    }  // note! waits for background compression
+    for (size_t i = 0; i <= settings.log.max_files; ++i) {
+      auto filename = i == 0 ? path : directory.get_path(fmt::format("test.{}.log.zst"sv, i));
+      std::string content;
+      if (i == 0 && compression == "none"sv) {
+        content = read_file(filename);
+      } else {
+        content = decompress(filename);
+      }
+      CHECK(std::size(content) > 0);
+      CHECK(std::size(content) <= settings.log.max_size);  // note! max size applies to the uncompressed text
+      CHECK(content.ends_with('\n'));
+      if (i == 0) {
+        CHECK(content.ends_with("index=999\n"sv));
+      }
+    }
+    // note! no other (staged) files
+    CHECK(std::distance(std::filesystem::directory_iterator{directory.path()}, {}) == static_cast<ptrdiff_t>(settings.log.max_files + 1));
+  }
+}
+
+// note! compression (and archiving) only applies to the primary sink
+TEST_CASE("ring_logger_compression_sinks", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  auto alerts = directory.get_path("alerts.log"sv);
+  auto sinks = fmt::format("file@warning={}"sv, alerts);
+  Settings settings;
+  settings.log.path = path;
+  settings.log.max_size = 4096;
+  settings.log.max_files = 2;
+  settings.log.compression = "zstd"sv;
+  settings.log.compression_rotated = "zstd"sv;
+  settings.log.sinks = sinks;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    for (size_t i = 0; i < 1000; ++i) {
+      log::warn("index={}"sv, i);
+    }
+  }
+  CHECK(decompress(path).ends_with("index=999\n"sv));
+  CHECK(read_file(alerts).ends_with("index=999\n"sv));
+  CHECK(std::filesystem::exists(directory.get_path("alerts.1.log"sv)));
+  CHECK(!std::filesystem::exists(directory.get_path("alerts.1.log.zst"sv)));
+}
+
+// note! a live compressed file left by a previous (e.g. crashed) process may end with an unterminated frame
+TEST_CASE("ring_logger_compression_reopen", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  std::string const stale{"\x28\xb5\x2f\xfd\x00"sv};  // note! zstd magic number and an incomplete frame header
+  std::ofstream{path, std::ios::binary} << stale;
+  Settings settings;
+  settings.log.path = path;
+  settings.log.max_files = 2;
+  settings.log.compression = "zstd"sv;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+    log::info("after"sv);
+  }
+  CHECK(decompress(path).ends_with("after\n"sv));
+  CHECK(read_file(directory.get_path("test.1.log"sv)) == stale);
+}
+
+// note! files staged by a previous (e.g. crashed) process are compressed when the logger is created
+TEST_CASE("ring_logger_compression_sweep", "[ring]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  auto stale = directory.get_path("test.log.12345.1.pending"sv);
+  auto other = directory.get_path("test.log.other.pending"sv);  // note! not staged by the archiver
+  for (auto &filename : {stale, other}) {
+    std::ofstream{filename} << "stale\n";
+  }
+  Settings settings;
+  settings.log.path = path;
+  settings.log.max_files = 2;
+  settings.log.compression_rotated = "zstd"sv;
+  {
+    auto handler = Factory::create("ring"sv, settings);
+  }  // note! waits for background compression
+  CHECK(std::filesystem::exists(stale) == false);
+  CHECK(std::filesystem::exists(other) == true);
+  CHECK(decompress(directory.get_path("test.1.log.zst"sv)) == "stale\n"sv);
+}
+#else
+TEST_CASE("ring_logger_compression", "[ring]") {
+  TemporaryDirectory directory;
+  Settings settings;
+  settings.log.path = directory.get_path("test.log"sv);
+  settings.log.compression = "zstd"sv;
+  CHECK_THROWS_AS(Factory::create("ring"sv, settings), RuntimeError);
+}
+#endif
+
+// note! a failure to rotate (here: the directory has been removed) must drop messages (not terminate) until the file can be opened
+TEST_CASE("ring_logger_rotate_failure", "[ring]") {
+  for (auto mmap : {false, true}) {
+    TemporaryDirectory directory;
+    auto logs = directory.get_path("logs"sv);
+    REQUIRE(std::filesystem::create_directory(logs));
+    auto path = fmt::format("{}/test.log"sv, logs);
+    Settings settings;
+    settings.log.path = path;
+    settings.log.max_size = 4096;
+    settings.log.max_files = 2;
+    settings.log.mmap = mmap;
+    {
+      auto handler = Factory::create("ring"sv, settings);
+      std::filesystem::remove_all(logs);
+      for (size_t i = 0; i < 1000; ++i) {
+        log::info("dropped={}"sv, i);
+      }
+      CHECK((*handler).drain(1s, false) == true);
+      REQUIRE(std::filesystem::create_directory(logs));
+      for (size_t i = 0; i < 10; ++i) {
+        log::info("index={}"sv, i);
+      }
+    }
+    auto content = read_file(path);
+    CHECK(content.find("dropped="sv) == content.npos);
+    CHECK(content.ends_with("index=9\n"sv));
+  }
+}
+
+// note! an empty file must never be rotated (history would otherwise be pushed out)
+TEST_CASE("ring_logger_rotate_large", "[ring]") {
+  for (auto mmap : {false, true}) {
+    TemporaryDirectory directory;
+    auto path = directory.get_path("test.log"sv);
+    Settings settings;
+    settings.log.path = path;
+    settings.log.max_size = 4096;
+    settings.log.max_files = 3;
+    settings.log.mmap = mmap;
+    settings.log.deferred = true;
+    settings.log.format = "binary"sv;  // note! prepares before writing
+    {
+      auto handler = Factory::create("ring"sv, settings);
+      for (size_t i = 0; i < 3; ++i) {
+        log::info("index={} {}"sv, i, std::string(6000, 'x'));  // note! exceeds max size
+      }
+    }
+    for (size_t i = 0; i <= settings.log.max_files; ++i) {
+      auto filename = i == 0 ? path : directory.get_path(fmt::format("test.{}.log"sv, i));
+      CHECK(std::filesystem::file_size(filename) > 0);
+    }
+  }
+}
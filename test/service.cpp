@@ -0,0 +1,73 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "roq/flags/args.hpp"
+
+#include "roq/service.hpp"
+
+#include "roq/logging.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+// note! the formatter remembers the thread it was called from
+struct Value final {
+  int value = {};
+};
+
+std::thread::id formatted_by;
+}  // namespace
+
+template <>
+struct roq::logging::is_deferrable<Value> : std::true_type {};
+
+template <>
+struct fmt::formatter<Value> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(Value const &value, format_context &context) const {
+    formatted_by = std::this_thread::get_id();
+    return fmt::format_to(context.out(), "value={}"sv, value.value);
+  }
+};
+
+namespace {
+struct MyService final : public Service {
+  using Service::Service;
+
+ protected:
+  int main(args::Parser const &) override {
+    log::info("{}"sv, Value{.value = 42});
+    return EXIT_SUCCESS;
+  }
+};
+}  // namespace
+
+TEST_CASE("service_deferred", "[service]") {
+  TemporaryDirectory directory;
+  auto path = directory.get_path("test.log"sv);
+  roq::flags::Args args{my_argc, my_argv, "test"sv, "test"sv};
+  Settings settings;
+  settings.log.path = path;
+  settings.log.deferred = true;  // note! must select the ring logger
+  {
+    MyService service{args, settings, {.description = "test"sv}};
+    CHECK(service.run() == EXIT_SUCCESS);
+  }
+  auto content = read_file(path);
+  CHECK(content.find("] value=42\n"sv) != content.npos);
+  // note! formatted by the backend thread
+  CHECK(formatted_by != std::thread::id{});
+  CHECK(formatted_by != std::this_thread::get_id());
+}
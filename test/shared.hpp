@@ -2,6 +2,62 @@
 
 #pragma once
 
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "roq/logging/handler.hpp"
+
 // SO5260907
 extern int my_argc;
 extern char **my_argv;
+
+// note! removed (including content) when going out of scope, also when a REQUIRE fails
+struct TemporaryDirectory final {
+  TemporaryDirectory() : path_{"/tmp/roq-logging-test-XXXXXX"} {
+    if (::mkdtemp(std::data(path_)) == nullptr) {
+      throw std::runtime_error{"Unable to create temporary directory"};
+    }
+  }
+
+  TemporaryDirectory(TemporaryDirectory const &) = delete;
+
+  ~TemporaryDirectory() {
+    std::error_code error;
+    std::filesystem::remove_all(path_, error);
+  }
+
+  std::string const &path() const { return path_; }
+
+  std::string get_path(std::string_view const &filename) const {
+    using namespace std::literals;
+    return fmt::format("{}/{}"sv, path_, filename);
+  }
+
+ private:
+  std::string path_;
+};
+
+inline std::string read_file(std::string const &path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file.is_open()) {
+    throw std::runtime_error{"Unable to open " + path};
+  }
+  return {std::istreambuf_iterator<char>{file}, {}};
+}
+
+// note! installs itself as the handler (messages are collected)
+struct Collector final : public roq::logging::Handler {
+  void operator()(roq::logging::Level, std::string_view const &message) override { messages_.emplace_back(message); }
+
+  std::vector<std::string> messages_;
+};
@@ -0,0 +1,263 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/factory.hpp"
+
+#include "roq/logging/shm/segment.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+auto get_name() {
+  return fmt::format("roq-logging-test-{}"sv, ::getpid());
+}
+
+auto read_all(shm::Segment &segment, bool skip_pending = false) {
+  std::vector<std::string> result;
+  auto callback = [&](auto &, auto &message) { result.emplace_back(message); };
+  shm::Segment::Status status = {};
+  segment.read(callback, SIZE_MAX, status, skip_pending);
+  return result;
+}
+}  // namespace
+
+TEST_CASE("shm_segment_simple", "[shm]") {
+  auto name = get_name();
+  auto producer = shm::Segment::create(name, 4096);
+  CHECK(producer.capacity() == 4096);
+  auto consumer = shm::Segment::open(name);
+  CHECK(consumer.header().producer_pid == ::getpid());
+  CHECK(producer.try_push(Level::INFO, std::chrono::nanoseconds{1}, 2, "hello"sv, true) == true);
+  CHECK(producer.try_push(Level::ERROR, std::chrono::nanoseconds{3}, 4, "world"sv, true) == true);
+  std::vector<std::string> messages;
+  auto callback = [&](auto &record, auto &message) {
+    if (std::empty(messages)) {
+      CHECK(record.level == Level::INFO);
+      CHECK(record.timestamp == 1);
+      CHECK(record.thread_id == 2);
+    }
+    messages.emplace_back(message);
+  };
+  shm::Segment::Status status = {};
+  CHECK(consumer.read(callback, SIZE_MAX, status) == 2);
+  CHECK(status == shm::Segment::Status::EMPTY);
+  REQUIRE(std::size(messages) == 2);
+  CHECK(messages[0] == "hello"sv);
+  CHECK(messages[1] == "world"sv);
+  CHECK(producer.size() == 0);
+  producer.unlink();
+}
+
+// note! an attached consumer is protected (nothing is overwritten before it has been consumed)
+TEST_CASE("shm_segment_wrap", "[shm]") {
+  auto name = get_name();
+  auto producer = shm::Segment::create(name, 4096);
+  auto consumer = shm::Segment::open(name);
+  consumer.header().consumer_pid = ::getpid();
+  auto text = std::string(96, 'x');  // note! 128 bytes including the record header
+  for (size_t i = 0; i < 32; ++i) {
+    CHECK(producer.try_push(Level::INFO, {}, {}, text, true) == true);
+  }
+  CHECK(producer.try_push(Level::INFO, {}, {}, text, true) == false);  // note! full
+  for (size_t i = 0; i < 100; ++i) {
+    auto message = fmt::format("{}{}"sv, text, i);
+    CHECK(std::size(read_all(consumer)) == (i == 0 ? 32 : 1));
+    CHECK(producer.try_push(Level::INFO, {}, {}, message, true) == true);
+  }
+  auto messages = read_all(consumer);
+  REQUIRE(std::size(messages) == 1);
+  CHECK(messages[0] == fmt::format("{}99"sv, text));
+  CHECK(producer.header().dropped == 0);
+  // note! truncated
+  CHECK(producer.try_push(Level::INFO, {}, {}, std::string(4096, 'x'), true) == true);
+  messages = read_all(consumer);
+  REQUIRE(std::size(messages) == 1);
+  CHECK(std::size(messages[0]) == producer.max_length());
+  producer.unlink();
+}
+
+// note! the most recent records are kept (consumed records are only overwritten when room is needed)
+TEST_CASE("shm_segment_overwrite", "[shm]") {
+  auto name = get_name();
+  auto producer = shm::Segment::create(name, 4096);
+  for (size_t i = 0; i < 1000; ++i) {
+    CHECK(producer.try_push(Level::INFO, {}, {}, fmt::format("index={}"sv, i), false) == true);
+  }
+  auto consumer = shm::Segment::open(name);
+  auto messages = read_all(consumer);
+  REQUIRE(std::size(messages) > 64);
+  auto first = 1000 - std::size(messages);
+  for (size_t i = 0; i < std::size(messages); ++i) {
+    CHECK(messages[i] == fmt::format("index={}"sv, first + i));
+  }
+  CHECK(consumer.size() == 0);
+  // note! attached and protected
+  consumer.header().consumer_pid = ::getpid();
+  size_t count = 0;
+  while (producer.try_push(Level::INFO, {}, {}, fmt::format("index={}"sv, 1000 + count), true)) {
+    ++count;
+  }
+  CHECK(count > 64);
+  messages = read_all(consumer);
+  REQUIRE(std::size(messages) == count);
+  CHECK(messages[0] == "index=1000"sv);
+  // note! not protected, what has not been consumed is counted as dropped
+  for (size_t i = 0; i < (2 * count); ++i) {
+    CHECK(producer.try_push(Level::INFO, {}, {}, "hello"sv, false) == true);
+  }
+  CHECK(producer.try_push(Level::INFO, {}, {}, "world"sv, false) == true);
+  CHECK(producer.header().dropped > 0);
+  messages = read_all(consumer);
+  REQUIRE(std::empty(messages) == false);
+  CHECK(messages.back() == "world"sv);
+  producer.unlink();
+}
+
+TEST_CASE("shm_segment_threads", "[shm]") {
+  auto name = get_name();
+  auto producer = shm::Segment::create(name, 65536);
+  auto consumer = shm::Segment::open(name);
+  consumer.header().consumer_pid = ::getpid();
+  size_t const thread_count = 4;
+  size_t const message_count = 10000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&, i]() {
+      for (size_t j = 0; j < message_count; ++j) {
+        auto message = fmt::format("{} {}"sv, i, j);
+        while (!producer.try_push(Level::INFO, {}, static_cast<uint32_t>(i), message, true)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::vector<size_t> next(thread_count);
+  size_t count = 0;
+  auto callback = [&](auto &record, auto &message) {
+    auto &expected = next[record.thread_id];
+    CHECK(message == fmt::format("{} {}"sv, record.thread_id, expected));
+    ++expected;
+    ++count;
+  };
+  while (count < (thread_count * message_count)) {
+    shm::Segment::Status status = {};
+    consumer.read(callback, SIZE_MAX, status);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  CHECK(consumer.size() == 0);
+  producer.unlink();
+}
+
+TEST_CASE("shm_segment_invalid", "[shm]") {
+  auto name = get_name();
+  CHECK_THROWS_AS(shm::Segment::create("a/b"sv, 4096), RuntimeError);
+  CHECK_THROWS_AS(shm::Segment::open(name), RuntimeError);
+  auto producer = shm::Segment::create(name, 4096);
+  producer.header().version = shm::Segment::VERSION + 1;
+  CHECK_THROWS_AS(shm::Segment::open(name), RuntimeError);
+  producer.unlink();
+}
+
+// note! the segment is kept until everything has been consumed
+TEST_CASE("shm_logger_unlink", "[shm]") {
+  auto name = get_name();
+  Settings settings;
+  settings.log.shm_name = name;
+  {
+    auto handler = Factory::create("shm"sv, settings);
+    log::info("hello"sv);
+  }
+  {
+    auto consumer = shm::Segment::open(name);
+    CHECK(std::size(read_all(consumer)) == 2);  // note! includes the initial message
+    auto handler = Factory::create("shm"sv, settings);  // note! replaces the segment
+    auto consumer_2 = shm::Segment::open(name);
+    CHECK(std::size(read_all(consumer_2)) == 1);
+  }
+  CHECK_THROWS_AS(shm::Segment::open(name), RuntimeError);
+}
+
+// note! published records must survive the process
+TEST_CASE("shm_logger_crash", "[shm]") {
+  auto name = get_name();
+  auto pid = ::fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    try {
+      Settings settings;
+      settings.log.shm_name = name;
+      auto handler = Factory::create("shm"sv, settings);
+      for (size_t i = 0; i < 100; ++i) {
+        log::info("index={}"sv, i);
+      }
+      ::raise(SIGKILL);
+    } catch (...) {
+    }
+    ::_exit(EXIT_FAILURE);  // note! not reached
+  }
+  int status = 0;
+  REQUIRE(::waitpid(pid, &status, 0) == pid);
+  CHECK(WIFSIGNALED(status));
+  auto consumer = shm::Segment::open(name);
+  CHECK(consumer.header().producer_pid == pid);
+  auto messages = read_all(consumer, true);
+  REQUIRE(std::size(messages) == 101);  // note! includes the initial message
+  CHECK(messages[0].starts_with("logging: shm"sv));
+  CHECK(messages[100].ends_with("index=99"sv));
+  consumer.unlink();
+}
+
+// note! the most recent records must survive the process (no consumer was ever attached)
+TEST_CASE("shm_logger_crash_overwrite", "[shm]") {
+  auto name = get_name();
+  auto pid = ::fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    try {
+      Settings settings;
+      settings.log.shm_name = name;
+      settings.log.queue_capacity = 4096;
+      auto handler = Factory::create("shm"sv, settings);
+      for (size_t i = 0; i < 1000; ++i) {
+        log::info("index={}"sv, i);
+      }
+      ::raise(SIGKILL);
+    } catch (...) {
+    }
+    ::_exit(EXIT_FAILURE);  // note! not reached
+  }
+  int status = 0;
+  REQUIRE(::waitpid(pid, &status, 0) == pid);
+  CHECK(WIFSIGNALED(status));
+  auto consumer = shm::Segment::open(name);
+  auto messages = read_all(consumer, true);
+  REQUIRE(std::size(messages) > 32);
+  REQUIRE(std::size(messages) < 1000);
+  auto first = 1000 - std::size(messages);
+  for (size_t i = 0; i < std::size(messages); ++i) {
+    CHECK(messages[i].ends_with(fmt::format("index={}"sv, first + i)));
+  }
+  consumer.unlink();
+}
@@ -0,0 +1,55 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/sinks.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+TEST_CASE("sinks_simple", "[sinks]") {
+  Settings settings;
+  settings.log.path = "/tmp/test.log"sv;
+  settings.log.sinks = " stderr@error, stdout ,file@warning=/tmp/alerts.log,"sv;
+  auto sinks = get_sinks(settings);
+  REQUIRE(std::size(sinks) == 3);
+  CHECK(sinks[0].type == SinkOptions::Type::STDERR);
+  CHECK(sinks[0].level == Level::ERROR);
+  CHECK(std::empty(sinks[0].path));
+  CHECK(sinks[1].type == SinkOptions::Type::STDOUT);
+  CHECK(sinks[1].level == Level::DEBUG);
+  CHECK(sinks[2].type == SinkOptions::Type::FILE);
+  CHECK(sinks[2].level == Level::WARNING);
+  CHECK(sinks[2].path == "/tmp/alerts.log"sv);
+}
+
+TEST_CASE("sinks_invalid", "[sinks]") {
+  auto create = [](auto sinks) {
+    Settings settings;
+    settings.log.path = "/tmp/test.log"sv;
+    settings.log.sinks = sinks;
+    return get_sinks(settings);
+  };
+  CHECK(std::empty(create(""sv)));
+  CHECK_THROWS_AS(create("syslog"sv), RuntimeError);
+  CHECK_THROWS_AS(create("stderr@fatal"sv), RuntimeError);
+  CHECK_THROWS_AS(create("stderr=/tmp/alerts.log"sv), RuntimeError);
+  CHECK_THROWS_AS(create("file@error"sv), RuntimeError);
+  CHECK_THROWS_AS(create("file=/tmp/test.log"sv), RuntimeError);
+  CHECK_THROWS_AS(create("file=/tmp/alerts.log,file@error=/tmp/alerts.log"sv), RuntimeError);
+  CHECK_THROWS_AS(create("stdout,stdout@error"sv), RuntimeError);
+  CHECK_THROWS_AS(create("stderr@warning,stderr"sv), RuntimeError);
+}
+
+// note! the primary sink is stdout when there is no log path
+TEST_CASE("sinks_stdout", "[sinks]") {
+  Settings settings;
+  settings.log.sinks = "stderr,file=/tmp/alerts.log"sv;
+  CHECK(std::size(get_sinks(settings)) == 2);
+  settings.log.sinks = "stdout@error"sv;
+  CHECK_THROWS_AS(get_sinks(settings), RuntimeError);
+}
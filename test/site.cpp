@@ -0,0 +1,95 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/site.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+Site const &helper(format_str const &fmt) {
+  return get_site(Level::INFO, 1, Prefix::DEFAULT, fmt);
+}
+
+Site const &helper_2(size_t verbosity) {
+  return get_site(Level::INFO, verbosity, Prefix::DEFAULT, "grow {}"sv);
+}
+
+Site const &helper_3(Level level, Prefix prefix) {
+  return get_site(level, 0, prefix, "same {}"sv);
+}
+}  // namespace
+
+TEST_CASE("site_simple", "[site]") {
+  Site const *sites[2] = {};
+  for (size_t i = 0; i < 2; ++i) {
+    sites[i] = &helper("hello {}"sv);
+  }
+  CHECK(sites[0] == sites[1]);
+  auto &site = *sites[0];
+  CHECK(site.index > 0);
+  CHECK(site.id != 0);
+  CHECK(site.level == Level::INFO);
+  CHECK(site.verbosity == 1);
+  CHECK(site.prefix == Prefix::DEFAULT);
+  CHECK(site.file_name.ends_with("site.cpp"sv));
+  CHECK(site.format == "hello {}"sv);
+  CHECK(site.header == fmt::format("L1 site.cpp:{}] "sv, site.line));
+  auto &other = helper("world {}"sv);
+  CHECK(&other != &site);
+  CHECK(other.index != site.index);
+  CHECK(other.id != site.id);
+  CHECK(other.line == site.line + 12);
+  auto all = get_sites();
+  CHECK(std::ranges::find(all, &site) != std::end(all));
+  CHECK(std::ranges::find(all, &other) != std::end(all));
+  CHECK(std::ranges::is_sorted(all, {}, [](auto site) { return (*site).index; }));
+}
+
+// note! more sites than the initial table can hold (the table must grow)
+TEST_CASE("site_grow", "[site]") {
+  auto count = std::size(get_sites());
+  std::vector<Site const *> sites;
+  for (size_t i = 0; i < 20000; ++i) {
+    sites.emplace_back(&helper_2(i));
+  }
+  CHECK(std::size(get_sites()) == (count + std::size(sites)));
+  for (size_t i = 0; i < std::size(sites); ++i) {
+    auto &site = helper_2(i);
+    CHECK(&site == sites[i]);
+    CHECK(site.verbosity == i);
+  }
+}
+
+// note! same call-site (file name, line and format string) used with different levels and prefixes
+TEST_CASE("site_id", "[site]") {
+  auto &site = helper_3(Level::INFO, Prefix::DEFAULT);
+  auto &site_2 = helper_3(Level::WARNING, Prefix::DEFAULT);
+  auto &site_3 = helper_3(Level::INFO, Prefix::DEBUG);
+  CHECK(site.id != site_2.id);
+  CHECK(site.id != site_3.id);
+  CHECK(site_2.id != site_3.id);
+  CHECK(helper_3(Level::INFO, Prefix::DEFAULT).id == site.id);
+}
+
+// note! the site is cached by the call-site (the registry is not probed again)
+TEST_CASE("site_cached", "[site]") {
+  struct Tag final {};
+  format_str const fmt{"cached {}"sv}, other{"other {}"sv};
+  auto &site = log::detail::get_site<Tag>(Level::INFO, 2, Prefix::DEFAULT, fmt);
+  CHECK(&site == &get_site(Level::INFO, 2, Prefix::DEFAULT, fmt));
+  auto count = std::size(get_sites());
+  auto &site_2 = log::detail::get_site<Tag>(Level::INFO, 2, Prefix::DEFAULT, other);
+  CHECK(&site_2 == &site);
+  CHECK(std::size(get_sites()) == count);
+}
@@ -0,0 +1,61 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+// note! compile-time filtering, must be defined before including any header
+#undef ROQ_LOGGING_MIN_LEVEL
+#undef ROQ_LOGGING_MAX_VERBOSITY
+#define ROQ_LOGGING_MIN_LEVEL 2
+#define ROQ_LOGGING_MAX_VERBOSITY 1
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+// note! only used by this translation unit (the log statements are compiled differently and must not be shared with other translation units)
+struct Value final {
+  int value = {};
+};
+}  // namespace
+
+template <>
+struct fmt::formatter<Value> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(Value const &value, format_context &context) const {
+    return fmt::format_to(context.out(), "{}"sv, value.value);
+  }
+};
+
+TEST_CASE("strip_simple", "[strip]") {
+  Collector collector;
+  verbosity = 5;  // note! stripped call-sites can't be enabled at runtime
+  log::debug("debug={}"sv, Value{1});
+  log::info("info={}"sv, Value{2});
+  log::warn("warn={}"sv, Value{3});
+  log::warn<1>("warn={}"sv, Value{4});
+  log::warn<2>("warn={}"sv, Value{5});
+  log::error("error={}"sv, Value{6});
+  log::error<3>("error={}"sv, Value{7});
+  verbosity = 0;
+  auto &messages = collector.messages_;
+  REQUIRE(std::size(messages) == 3);
+  CHECK(messages[0].ends_with("] warn=3"sv));
+  CHECK(messages[1].ends_with("] warn=4"sv));
+  CHECK(messages[2].ends_with("] error=6"sv));
+  // note! stripped call-sites are never registered
+  for (auto site : get_sites()) {
+    if (get_basename((*site).file_name) == "strip.cpp"sv) {
+      CHECK((*site).level >= Level::WARNING);
+      CHECK((*site).verbosity <= 1);
+    }
+  }
+}
@@ -0,0 +1,76 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+// note! two-phase (formats straight into a bounded buffer)
+struct Reserve final : public Handler {
+  Reserve() : Handler{true} {}
+
+  void operator()(Level, std::string_view const &message) override { messages_.emplace_back(message); }
+
+  std::span<char> reserve(Level) override { return buffer_; }
+  void commit(Level, size_t length) override {
+    if (length != 0) {
+      messages_.emplace_back(std::data(buffer_), length);
+    }
+  }
+
+  std::array<char, 64> buffer_ = {};
+  std::vector<std::string> messages_;
+};
+}  // namespace
+
+TEST_CASE("structured_logfmt", "[structured]") {
+  Collector collector;
+  structured_encoding = Encoding::LOGFMT;
+  uint64_t order_id = 123;
+  auto latency = 4.5;
+  log::info_kv("order_ack"sv, log::kv("order_id", order_id), log::kv("latency_us", latency), log::kv("ok", true));
+  log::warn_kv("reject"sv, log::kv("reason", "too late"sv), log::kv("code", 'X'), log::kv("empty", ""sv));
+  log::error_kv("escape"sv, log::kv("text", "a\"b\\c\n"sv));
+  auto &messages = collector.messages_;
+  REQUIRE(std::size(messages) == 3);
+  CHECK(messages[0].ends_with("] event=order_ack order_id=123 latency_us=4.5 ok=true"sv));
+  CHECK(messages[1].ends_with(R"(] event=reject reason="too late" code=X empty="")"sv));
+  CHECK(messages[2].ends_with(R"(] event=escape text="a\"b\\c\n")"sv));
+}
+
+TEST_CASE("structured_json", "[structured]") {
+  Collector collector;
+  structured_encoding = Encoding::JSON;
+  log::info_kv("order_ack"sv, log::kv("order_id", 123), log::kv("symbol", "BTC-PERP"sv), log::kv("price", NAN));
+  log::info_kv("empty"sv);
+  structured_encoding = Encoding::LOGFMT;
+  auto &messages = collector.messages_;
+  REQUIRE(std::size(messages) == 2);
+  CHECK(messages[0].ends_with(R"(] {"event":"order_ack","order_id":123,"symbol":"BTC-PERP","price":null})"sv));
+  CHECK(messages[1].ends_with(R"(] {"event":"empty"})"sv));
+}
+
+TEST_CASE("structured_truncated", "[structured]") {
+  Reserve reserve;
+  auto text = std::string(100, 'x');
+  log::info_kv("short"sv, log::kv("value", 1));
+  log::info_kv("long"sv, log::kv("text", text));  // note! too long for the reserved buffer
+  auto &messages = reserve.messages_;
+  REQUIRE(std::size(messages) == 2);
+  CHECK(messages[0].ends_with("] event=short value=1"sv));
+  CHECK(messages[1].ends_with(fmt::format("] event=long text={}"sv, text)));
+}
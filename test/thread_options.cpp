@@ -0,0 +1,79 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <array>
+#include <string>
+#include <thread>
+
+#include "roq/exceptions.hpp"
+
+#include "roq/logging/thread_options.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+TEST_CASE("thread_options_simple", "[thread_options]") {
+  // note! any cpu we're allowed to run on
+  cpu_set_t allowed = {};
+  REQUIRE(::sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+  auto cpu = 0uz;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    ++cpu;
+  }
+  auto affinity = fmt::format("{}"sv, cpu);
+  Settings settings;
+  settings.log.thread_name = "test-logging"sv;
+  settings.log.thread_affinity = affinity;
+  settings.log.thread_policy = "batch"sv;
+  ThreadOptions thread_options{settings};
+  std::array<char, 16> name = {};
+  cpu_set_t result = {};
+  auto policy = -1;
+  std::string error;
+  std::thread{[&]() {
+    error = thread_options();
+    ::pthread_getname_np(::pthread_self(), std::data(name), std::size(name));
+    ::sched_getaffinity(0, sizeof(result), &result);
+    policy = ::sched_getscheduler(0);
+  }}.join();
+  CHECK(std::empty(error));
+  CHECK(std::string_view{std::data(name)} == "test-logging"sv);
+  CHECK(CPU_COUNT(&result) == 1);
+  CHECK(CPU_ISSET(cpu, &result));
+  CHECK(policy == SCHED_BATCH);
+}
+
+// note! failures are returned (the backend thread must not log)
+TEST_CASE("thread_options_failure", "[thread_options]") {
+  Settings settings;
+  settings.log.thread_affinity = fmt::format("{}"sv, CPU_SETSIZE - 1);  // note! assumed to not exist
+  ThreadOptions thread_options{settings};
+  std::string error;
+  std::thread{[&]() { error = thread_options(); }}.join();
+  CHECK(error.starts_with("unable to set thread affinity (error="sv));
+}
+
+TEST_CASE("thread_options_invalid", "[thread_options]") {
+  auto create = [](auto &&update) {
+    Settings settings;
+    update(settings);
+    ThreadOptions{settings};
+  };
+  CHECK_NOTHROW(create([](auto &settings) { settings.log.thread_affinity = "0,2-3"sv; }));
+  CHECK_THROWS_AS(create([](auto &settings) { settings.log.thread_name = "this-name-is-too-long"sv; }), RuntimeError);
+  CHECK_THROWS_AS(create([](auto &settings) { settings.log.thread_affinity = "1-"sv; }), RuntimeError);
+  CHECK_THROWS_AS(create([](auto &settings) { settings.log.thread_affinity = "3-1"sv; }), RuntimeError);
+  CHECK_THROWS_AS(create([](auto &settings) { settings.log.thread_affinity = "x"sv; }), RuntimeError);
+  CHECK_THROWS_AS(create([](auto &settings) { settings.log.thread_policy = "unknown"sv; }), RuntimeError);
+  CHECK_THROWS_AS(create([](auto &settings) { settings.log.thread_priority = 20; }), RuntimeError);
+  CHECK_THROWS_AS(create([](auto &settings) {
+    settings.log.thread_policy = "fifo"sv;
+    settings.log.thread_priority = 0;
+  }), RuntimeError);
+}
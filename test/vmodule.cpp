@@ -0,0 +1,71 @@
+/* Copyright (c) 2017-2026, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+#include "roq/logging/vmodule.hpp"
+
+#include "./shared.hpp"
+
+using namespace std::literals;
+
+using namespace roq;
+using namespace roq::logging;
+
+namespace {
+void helper(size_t index) {
+  log::info<1>("index={}"sv, index);
+  log::info<3>("index={}"sv, index);
+}
+}  // namespace
+
+TEST_CASE("vmodule_simple", "[vmodule]") {
+  Collector collector;
+  auto &messages = collector.messages_;
+  REQUIRE(verbosity == 0);
+  helper(0);
+  CHECK(std::size(messages) == 0);
+  set_vmodule("other=5, vmod*=1"sv);
+  helper(1);
+  REQUIRE(std::size(messages) == 1);
+  CHECK(messages[0].starts_with("L1 "sv));
+  CHECK(messages[0].ends_with("] index=1"sv));
+  set_vmodule("*/vmodule.cpp=3,vmodule=1"sv);  // note! first match wins
+  helper(2);
+  REQUIRE(std::size(messages) == 3);
+  CHECK(messages[2].starts_with("L3 "sv));
+  set_vmodule("vmodule.cpp=3"sv);  // note! extension is not part of the module name
+  helper(3);
+  CHECK(std::size(messages) == 3);
+  set_vmodule({});
+  helper(4);
+  CHECK(std::size(messages) == 3);
+  CHECK_THROWS(set_vmodule("vmodule"sv));
+  CHECK_THROWS(set_vmodule("vmodule=x"sv));
+  CHECK_THROWS(set_vmodule("=1"sv));
+}
+
+TEST_CASE("vmodule_lower", "[vmodule]") {
+  Collector collector;
+  auto &messages = collector.messages_;
+  REQUIRE(verbosity == 0);
+  verbosity = 3;
+  helper(0);
+  CHECK(std::size(messages) == 2);
+  set_vmodule("vmodule=0"sv);  // note! a matching pattern also lowers the verbosity
+  helper(1);
+  CHECK(std::size(messages) == 2);
+  set_vmodule("vmodule=1"sv);
+  helper(2);
+  REQUIRE(std::size(messages) == 3);
+  CHECK(messages[2].starts_with("L1 "sv));
+  set_vmodule("other=0"sv);  // note! no match, the global verbosity applies
+  helper(3);
+  CHECK(std::size(messages) == 5);
+  set_vmodule({});
+  verbosity = 0;
+}